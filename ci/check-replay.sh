@@ -0,0 +1,51 @@
+#!/bin/bash
+# check that the Verilator harness records and replays deterministically
+#
+# $1 Verilator harness
+# $2 test binary
+# $3 random seed
+# $4 directory for the replay logs
+#
+
+ROOT=$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)
+cd $ROOT
+
+HARNESS=$1
+TEST=$2
+SEED=$3
+DIR=$4
+
+# run the harness, keep its output and exit code
+# $1 run name, remaining arguments are passed to the harness
+run() {
+  local name=$1
+  shift
+  $HARNESS "$@" $TEST 2> $DIR/$name.out
+  echo $? > $DIR/$name.code
+  cat $DIR/$name.out
+  grep -o "after [0-9]* cycles" $DIR/$name.out > $DIR/$name.cycles
+}
+
+run replay_0 --seed=$SEED --record=$DIR/replay_0.log
+run replay_1 --seed=$SEED --record=$DIR/replay_1.log
+run replay_2 --replay=$DIR/replay_0.log
+
+# two runs with the same seed need to produce identical replay logs
+if ! cmp $DIR/replay_0.log $DIR/replay_1.log; then
+  echo "FAILED two runs with seed $SEED recorded different inputs"
+  exit 1
+fi
+
+# replaying the first run needs to end the same way after the same number of cycles
+if ! cmp -s $DIR/replay_0.code $DIR/replay_2.code; then
+  echo "FAILED replay exited with $(cat $DIR/replay_2.code), recorded run with $(cat $DIR/replay_0.code)"
+  exit 1
+fi
+
+if [ ! -s $DIR/replay_0.cycles ] || ! cmp -s $DIR/replay_0.cycles $DIR/replay_2.cycles; then
+  echo "FAILED replay ended $(cat $DIR/replay_2.cycles), recorded run $(cat $DIR/replay_0.cycles)"
+  exit 1
+fi
+
+echo "PASSED replay of $TEST (seed $SEED) after $(cat $DIR/replay_0.cycles | cut -d ' ' -f 2) cycles"
+exit 0
@@ -47,6 +47,7 @@ module ariane_peripherals #(
     inout  wire        eth_mdio        ,
     output logic       eth_mdc         ,
     // SPI
+    input  logic       spi_clk_i       , // fast SPI reference clock
     output logic       spi_clk_o       ,
     output logic       spi_mosi        ,
     input  logic       spi_miso        ,
@@ -294,7 +295,13 @@ module ariane_peripherals #(
     assign spi.b_user = 1'b0;
     assign spi.r_user = 1'b0;
 
+    // SPI clock select, driven by the upper GPIO output bit. The quad SPI
+    // has a fixed SCK ratio of 4 so the SD card gets identified at clk_i / 4
+    // and the software can switch to spi_clk_i / 4 afterwards.
+    logic spi_clk_sel;
+
     if (InclSPI) begin : gen_spi
+        logic        ext_spi_clk;
         logic [31:0] s_axi_spi_awaddr;
         logic [7:0]  s_axi_spi_awlen;
         logic [2:0]  s_axi_spi_awsize;
@@ -412,8 +419,16 @@ module ariane_peripherals #(
             .m_axi_rready   ( s_axi_spi_rready   )
         );
 
+        // glitch free switch between the identification and transfer clock
+        BUFGMUX_CTRL i_bufgmux_spi_clk (
+            .O  ( ext_spi_clk ),
+            .I0 ( clk_i       ),
+            .I1 ( spi_clk_i   ),
+            .S  ( spi_clk_sel )
+        );
+
         xlnx_axi_quad_spi i_xlnx_axi_quad_spi (
-            .ext_spi_clk    ( clk_i                  ),
+            .ext_spi_clk    ( ext_spi_clk            ),
             .s_axi4_aclk    ( clk_i                  ),
             .s_axi4_aresetn ( rst_ni                 ),
             .s_axi4_awaddr  ( s_axi_spi_awaddr[23:0] ),
@@ -710,13 +725,15 @@ framing_top eth_rgmii
             .s_axi_rvalid  ( s_axi_gpio_rvalid      ),
             .s_axi_rready  ( s_axi_gpio_rready      ),
             .gpio_io_i     ( '0                     ),
-            .gpio_io_o     ( leds_o                 ),
+            .gpio_io_o     ( {spi_clk_sel, leds_o}  ),
             .gpio_io_t     (                        ),
             .gpio2_io_i    ( dip_switches_i         )
         );
 
         assign s_axi_gpio_rlast = 1'b1;
         assign s_axi_gpio_wlast = 1'b1;
+    end else begin
+        assign spi_clk_sel = 1'b0;
     end
 endmodule
 
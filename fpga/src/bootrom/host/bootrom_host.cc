@@ -0,0 +1,327 @@
+// Description: Host side harness for the zero stage bootloader. The bootrom
+//              sources are compiled natively with BOOTROM_HOST, every
+//              peripheral access ends up in host_mmio_read/write and is
+//              served by a register model. Model time advances with every
+//              access (bus latency) and with the peripheral timing (SPI
+//              shifter, UART baud rate), the compute time of the core is not
+//              modelled. This is meant to compare bootloader changes (SPI
+//              FIFO usage, CRC strategies, read-ahead, ...) without an FPGA.
+
+#include <errno.h>
+#include <getopt.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include <chrono>
+#include <cstdio>
+
+#include "sd_card.h"
+#include "peripherals.h"
+#include "eth_model.h"
+#include "platform.h"
+
+extern "C" int bootrom_main();
+
+#define UART_BASE 0x10000000
+#define SPI_BASE 0x20000000
+#define ETH_BASE 0x30000000
+#define GPIO_BASE 0x40000000
+#define DEVICE_SIZE 0x10000000
+
+enum device_t {UART, SPI, ETH, GPIO, NR_DEVICES};
+static const char* device_names[NR_DEVICES] = {"uart:", "spi:", "eth:", "gpio:"};
+
+static uint64_t now_ns = 0;
+static uint64_t mmio_ns = 0;
+static uint64_t cycle_ns = 20;   // 50 MHz
+static uint64_t timeout_ns = 0;
+static uint64_t reads[NR_DEVICES];
+static uint64_t writes[NR_DEVICES];
+
+static sd_card_t* card;
+static gpio_t* gpio;
+static axi_quad_spi_t* spi;
+static uart_t* uart;
+static eth_model_t* eth;
+
+static void report();
+
+static device_t decode(uintptr_t addr)
+{
+  switch (addr & ~(uintptr_t)(DEVICE_SIZE - 1)) {
+    case UART_BASE: return UART;
+    case SPI_BASE: return SPI;
+    case ETH_BASE: return ETH;
+    case GPIO_BASE: return GPIO;
+    default:
+      fprintf(stderr, "bootrom_host: access to unmapped address 0x%lx\n",
+              (unsigned long)addr);
+      abort();
+  }
+}
+
+// every access costs the bus round trip, a bootrom which never finishes
+// (e.g.: polling a status bit forever) is stopped after the timeout
+static void tick()
+{
+  now_ns += mmio_ns;
+  if (timeout_ns && now_ns > timeout_ns) {
+    fflush(stdout);
+    fprintf(stderr, "\nbootrom_host: timeout after %.3f ms of model time\n",
+            now_ns / 1e6);
+    report();
+    exit(2);
+  }
+}
+
+extern "C" uint64_t host_mmio_read(uintptr_t addr, int size)
+{
+  device_t dev = decode(addr);
+  uint32_t offset = addr & (DEVICE_SIZE - 1);
+
+  tick();
+  reads[dev]++;
+
+  switch (dev) {
+    case UART: return uart->read(offset, now_ns);
+    case SPI: return spi->read(offset, now_ns);
+    case ETH: return eth->read(offset, now_ns);
+    case GPIO: return gpio->read(offset);
+    default: return 0;
+  }
+}
+
+extern "C" void host_mmio_write(uintptr_t addr, uint64_t value, int size)
+{
+  device_t dev = decode(addr);
+  uint32_t offset = addr & (DEVICE_SIZE - 1);
+
+  tick();
+  writes[dev]++;
+
+  switch (dev) {
+    case UART: uart->write(offset, value, now_ns); break;
+    case SPI: spi->write(offset, value, now_ns); break;
+    case ETH: eth->write(offset, value, now_ns); break;
+    case GPIO: gpio->write(offset, value); break;
+    default: break;
+  }
+}
+
+extern "C" uint64_t host_cycle()
+{
+  return now_ns / cycle_ns;
+}
+
+static void report()
+{
+  fprintf(stderr, "\n");
+  fprintf(stderr, "model time:   %.3f ms (%lu cycles)\n",
+          now_ns / 1e6, (unsigned long)host_cycle());
+  for (int i = 0; i < NR_DEVICES; i++)
+    fprintf(stderr, "%-13s %lu reads, %lu writes\n", device_names[i],
+            (unsigned long)reads[i], (unsigned long)writes[i]);
+  if (spi->bytes_slow + spi->bytes_fast) {
+    fprintf(stderr, "spi bytes:    %lu slow, %lu fast, busy %.3f ms (%.1f%%)\n",
+            (unsigned long)spi->bytes_slow, (unsigned long)spi->bytes_fast,
+            spi->busy_ns / 1e6, now_ns ? 100.0 * spi->busy_ns / now_ns : 0.0);
+    if (spi->tx_overruns || spi->rx_overruns || spi->rx_underruns)
+      fprintf(stderr, "spi errors:   %lu tx overruns, %lu rx overruns, %lu rx underruns\n",
+              (unsigned long)spi->tx_overruns, (unsigned long)spi->rx_overruns,
+              (unsigned long)spi->rx_underruns);
+    fprintf(stderr, "sd commands: ");
+    for (int i = 0; i < 64; i++) {
+      if (card->commands[i])
+        fprintf(stderr, " CMD%d x%lu", i, (unsigned long)card->commands[i]);
+    }
+    fprintf(stderr, "\n");
+    fprintf(stderr, "sd blocks:    %lu read, %lu corrupted\n",
+            (unsigned long)card->blocks_read, (unsigned long)card->crc_errors_injected);
+    if (card->blocks_read && now_ns)
+      fprintf(stderr, "sd throughput: %.2f MiB/s\n",
+              card->blocks_read * 512.0 / (1 << 20) / (now_ns / 1e9));
+  }
+  fprintf(stderr, "uart chars:   %lu, %lu overruns\n",
+          (unsigned long)uart->chars, (unsigned long)uart->overruns);
+  if (eth->frames_tx || eth->frames_rx)
+    fprintf(stderr, "eth frames:   %lu (%lu bytes) sent, %lu (%lu bytes) received\n",
+            (unsigned long)eth->frames_tx, (unsigned long)eth->bytes_tx,
+            (unsigned long)eth->frames_rx, (unsigned long)eth->bytes_rx);
+}
+
+// compare the beginning of DRAM with the payload the bootrom should load
+static bool check(const char* filename)
+{
+  FILE* f = fopen(filename, "rb");
+  if (!f) {
+    fprintf(stderr, "bootrom_host failed to open %s: %s (%d)\n",
+            filename, strerror(errno), errno);
+    return false;
+  }
+
+  const uint8_t* mem = (const uint8_t*)DRAM_BASE;
+  uint8_t buf[4096];
+  uint64_t offset = 0;
+  size_t n;
+  bool ok = true;
+
+  while (ok && (n = fread(buf, 1, sizeof(buf), f)) > 0) {
+    if (offset + n > DRAM_SIZE) {
+      fprintf(stderr, "%s is larger than the memory\n", filename);
+      ok = false;
+      break;
+    }
+    for (size_t i = 0; i < n; i++) {
+      if (mem[offset + i] != buf[i]) {
+        fprintf(stderr, "mismatch at 0x%lx: expected 0x%02x, got 0x%02x\n",
+                (unsigned long)(DRAM_BASE + offset + i), buf[i], mem[offset + i]);
+        ok = false;
+        break;
+      }
+    }
+    offset += n;
+  }
+  fclose(f);
+
+  if (ok)
+    fprintf(stderr, "memory matches %s (%lu bytes)\n", filename, (unsigned long)offset);
+  return ok;
+}
+
+static void usage(const char * program_name) {
+  printf("Usage: %s [OPTION]...\n", program_name);
+  fputs("\
+Run the zero stage bootloader against models of the SoC peripherals.\n\
+\n\
+Mandatory arguments to long options are mandatory for short options too.\n\
+\n\
+  -s, --sd-image=FILE      Insert an SD card backed by FILE (e.g. made with\n\
+                           mkdisk.py). Without it there is no card.\n\
+  -e, --expect=FILE        Check that the loaded image matches FILE, the exit\n\
+                           code is non-zero otherwise.\n\
+  -d, --dip=VALUE          State of the DIP switches (0x80 selects netboot).\n\
+  -t, --tftp-port=PORT     Forward TFTP requests to PORT on localhost\n\
+                           (default 69), e.g. for tftp_server.py --port.\n\
+  -m, --mmio-cycles=N      Core cycles per peripheral access (default 16).\n\
+  -f, --frequency=MHZ      Core and bus clock (default 50).\n\
+      --spi-slow=NS        Time per SPI byte with the slow clock (default 640).\n\
+      --spi-fast=NS        Time per SPI byte with the transfer clock\n\
+                           (default 320).\n\
+      --baud=RATE          UART baud rate (default 115200).\n\
+      --nac=N              Bytes before each data token of the card (default 8).\n\
+  -c, --corrupt-lba=LBA    Corrupt the first fast transfer of block LBA to\n\
+                           exercise the CRC retry path.\n\
+  -T, --timeout=MS         Stop after MS milliseconds of model time\n\
+                           (default 60000).\n\
+  -q, --quiet              Don't print the UART output.\n\
+  -h, --help               Display this help and exit.\n\
+\n\
+Statistics (model time, accesses per device, SPI bytes and utilization, SD\n\
+commands and throughput) are printed to stderr when the bootrom returns.\n\
+", stdout);
+}
+
+int main(int argc, char **argv) {
+  const char* sd_image = NULL;
+  const char* expect = NULL;
+  uint32_t dip = 0;
+  uint16_t tftp_port = 69;
+  uint64_t mmio_cycles = 16;
+  uint64_t mhz = 50;
+  uint64_t spi_slow_ns = 640;
+  uint64_t spi_fast_ns = 320;
+  uint64_t baud = 115200;
+  unsigned nac = 8;
+  int64_t corrupt_lba = -1;
+  uint64_t timeout_ms = 60000;
+  bool quiet = false;
+
+  while (1) {
+    static struct option long_options[] = {
+      {"sd-image",    required_argument, 0, 's' },
+      {"expect",      required_argument, 0, 'e' },
+      {"dip",         required_argument, 0, 'd' },
+      {"tftp-port",   required_argument, 0, 't' },
+      {"mmio-cycles", required_argument, 0, 'm' },
+      {"frequency",   required_argument, 0, 'f' },
+      {"spi-slow",    required_argument, 0, 'S' },
+      {"spi-fast",    required_argument, 0, 'F' },
+      {"baud",        required_argument, 0, 'B' },
+      {"nac",         required_argument, 0, 'N' },
+      {"corrupt-lba", required_argument, 0, 'c' },
+      {"timeout",     required_argument, 0, 'T' },
+      {"quiet",       no_argument,       0, 'q' },
+      {"help",        no_argument,       0, 'h' },
+      {0, 0, 0, 0}
+    };
+    int option_index = 0;
+    int c = getopt_long(argc, argv, "s:e:d:t:m:f:c:T:qh", long_options, &option_index);
+    if (c == -1) break;
+    switch (c) {
+      case 's': sd_image = optarg; break;
+      case 'e': expect = optarg; break;
+      case 'd': dip = strtoul(optarg, 0, 0); break;
+      case 't': tftp_port = strtoul(optarg, 0, 0); break;
+      case 'm': mmio_cycles = strtoull(optarg, 0, 0); break;
+      case 'f': mhz = strtoull(optarg, 0, 0); break;
+      case 'S': spi_slow_ns = strtoull(optarg, 0, 0); break;
+      case 'F': spi_fast_ns = strtoull(optarg, 0, 0); break;
+      case 'B': baud = strtoull(optarg, 0, 0); break;
+      case 'N': nac = strtoul(optarg, 0, 0); break;
+      case 'c': corrupt_lba = strtoll(optarg, 0, 0); break;
+      case 'T': timeout_ms = strtoull(optarg, 0, 0); break;
+      case 'q': quiet = true; break;
+      case 'h': usage(argv[0]); return 0;
+      default: usage(argv[0]); return 1;
+    }
+  }
+
+  if (mhz == 0 || mhz > 1000 || baud == 0) {
+    usage(argv[0]);
+    return 1;
+  }
+  cycle_ns = 1000 / mhz;
+  mmio_ns = mmio_cycles * cycle_ns;
+  timeout_ns = timeout_ms * 1000000;
+
+  // the bootrom addresses DRAM directly
+  void* dram = mmap((void*)DRAM_BASE, DRAM_SIZE, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_FIXED_NOREPLACE, -1, 0);
+  if (dram != (void*)DRAM_BASE) {
+    fprintf(stderr, "bootrom_host failed to map the DRAM at 0x%lx: %s (%d)\n",
+            (unsigned long)DRAM_BASE, strerror(errno), errno);
+    return 1;
+  }
+
+  card = new sd_card_t(sd_image);
+  card->set_nac(nac);
+  card->set_corrupt_lba(corrupt_lba);
+  gpio = new gpio_t(dip);
+  spi = new axi_quad_spi_t(card, gpio, spi_slow_ns, spi_fast_ns);
+  // start, 8 data and stop bit
+  uart = new uart_t(10 * 1000000000ull / baud, !quiet);
+  // 100 Mbit/s
+  eth = new eth_model_t(tftp_port, 80);
+
+  auto start = std::chrono::steady_clock::now();
+  int res = bootrom_main();
+  auto stop = std::chrono::steady_clock::now();
+
+  fflush(stdout);
+  report();
+  fprintf(stderr, "bootrom:      returned %d after %.3f s host time\n", res,
+          std::chrono::duration<double>(stop - start).count());
+
+  if (res == 0 && expect && !check(expect))
+    res = 1;
+
+  delete eth;
+  delete uart;
+  delete spi;
+  delete gpio;
+  delete card;
+  munmap(dram, DRAM_SIZE);
+
+  return res == 0 ? 0 : 1;
+}
@@ -0,0 +1,265 @@
+// Description: Register model of the lowRISC Ethernet MAC (framing_top) for
+//              the host side bootrom harness
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+#include <cstdio>
+
+#include "eth_model.h"
+
+#define ETH_MACLO 0x0800
+#define ETH_MACHI 0x0808
+#define ETH_TPLR 0x0810
+#define ETH_RSR 0x0830
+#define ETH_RPLR 0x0840
+#define ETH_TXBUFF 0x1000
+#define ETH_RXBUFF 0x4000
+
+#define ETH_RX_BUFFERS 8
+#define ETH_BUFFER_SIZE 0x800
+
+#define ETH_RSR_DONE 0x1000
+#define ETH_TPLR_BUSY 0x80000000
+
+#define ETH_TYPE_IP 0x0800
+#define ETH_TYPE_ARP 0x0806
+
+// preamble, FCS and inter frame gap
+#define ETH_FRAME_OVERHEAD 24
+
+static const uint8_t server_mac[6] = {0x02, 0x00, 0x00, 0x00, 0x00, 0xfe};
+
+static uint16_t get16(const uint8_t* p)
+{
+  return (p[0] << 8) | p[1];
+}
+
+static void put16(uint8_t* p, uint16_t v)
+{
+  p[0] = v >> 8;
+  p[1] = v;
+}
+
+eth_model_t::eth_model_t(uint16_t tftp_port, uint64_t byte_ns) :
+  frames_tx(0),
+  frames_rx(0),
+  bytes_tx(0),
+  bytes_rx(0),
+  tftp_port(tftp_port),
+  byte_ns(byte_ns),
+  tx_busy_until(0),
+  first(0),
+  client_port(0)
+{
+  memset(mac, 0, sizeof(mac));
+  memset(txbuff, 0, sizeof(txbuff));
+  memset(client_mac, 0, sizeof(client_mac));
+  memset(client_ip, 0, sizeof(client_ip));
+  memset(server_ip, 0, sizeof(server_ip));
+
+  sock = socket(AF_INET, SOCK_DGRAM, 0);
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  if (sock < 0 || bind(sock, (struct sockaddr*)&addr, sizeof(addr)) < 0 ||
+      fcntl(sock, F_SETFL, O_NONBLOCK) < 0) {
+    fprintf(stderr, "eth_model failed to open a socket: %s (%d)\n",
+            strerror(errno), errno);
+    abort();
+  }
+}
+
+eth_model_t::~eth_model_t()
+{
+  close(sock);
+}
+
+uint64_t eth_model_t::read(uint32_t offset, uint64_t now)
+{
+  switch (offset) {
+    case ETH_MACLO:
+      return ((uint32_t)mac[2] << 24) | (mac[3] << 16) | (mac[4] << 8) | mac[5];
+    case ETH_MACHI:
+      return (mac[0] << 8) | mac[1];
+    case ETH_TPLR:
+      return now < tx_busy_until ? ETH_TPLR_BUSY : 0;
+    case ETH_RSR:
+      poll();
+      return (rx.empty() ? 0 : ETH_RSR_DONE) | (first % ETH_RX_BUFFERS);
+  }
+
+  if (offset >= ETH_RPLR && offset < ETH_RPLR + 8 * ETH_RX_BUFFERS) {
+    uint32_t buf = (offset - ETH_RPLR) / 8;
+    if (rx.empty() || buf != first % ETH_RX_BUFFERS)
+      return 0;
+    return rx.front().size();
+  }
+
+  if (offset >= ETH_TXBUFF && offset < ETH_TXBUFF + ETH_BUFFER_SIZE) {
+    uint64_t value;
+    memcpy(&value, txbuff + (offset - ETH_TXBUFF), sizeof(value));
+    return value;
+  }
+
+  if (offset >= ETH_RXBUFF && offset < ETH_RXBUFF + ETH_RX_BUFFERS * ETH_BUFFER_SIZE) {
+    uint32_t buf = (offset - ETH_RXBUFF) / ETH_BUFFER_SIZE;
+    uint32_t pos = (offset - ETH_RXBUFF) % ETH_BUFFER_SIZE;
+    uint64_t value = 0;
+    if (rx.empty() || buf != first % ETH_RX_BUFFERS)
+      return 0;
+    const std::vector<uint8_t>& frame = rx.front();
+    for (int i = 0; i < 8 && pos + i < frame.size(); i++)
+      value |= (uint64_t)frame[pos + i] << (i * 8);
+    return value;
+  }
+
+  return 0;
+}
+
+void eth_model_t::write(uint32_t offset, uint64_t value, uint64_t now)
+{
+  switch (offset) {
+    case ETH_MACLO:
+      mac[2] = value >> 24;
+      mac[3] = value >> 16;
+      mac[4] = value >> 8;
+      mac[5] = value;
+      return;
+    case ETH_MACHI:
+      mac[0] = value >> 8;
+      mac[1] = value;
+      return;
+    case ETH_TPLR:
+      tx_busy_until = now + ((value & 0xfff) + ETH_FRAME_OVERHEAD) * byte_ns;
+      transmit(value & 0xfff);
+      return;
+    case ETH_RSR:
+      // hand the first buffer back
+      if (!rx.empty() && (value & 0xf) == (first % ETH_RX_BUFFERS) + 1) {
+        rx.pop_front();
+        first++;
+      }
+      return;
+  }
+
+  if (offset >= ETH_TXBUFF && offset < ETH_TXBUFF + ETH_BUFFER_SIZE)
+    memcpy(txbuff + (offset - ETH_TXBUFF), &value, sizeof(value));
+}
+
+void eth_model_t::transmit(uint32_t len)
+{
+  const uint8_t* f = txbuff;
+
+  if (len > sizeof(txbuff) || len < 14)
+    return;
+
+  frames_tx++;
+  bytes_tx += len;
+
+  uint16_t type = get16(f + 12);
+
+  // answer every ARP request, the server sits behind server_mac
+  if (type == ETH_TYPE_ARP && len >= 14 + 28 && get16(f + 14 + 6) == 1) {
+    std::vector<uint8_t> r(60, 0);
+    memcpy(&r[0], f + 6, 6);
+    memcpy(&r[6], server_mac, 6);
+    put16(&r[12], ETH_TYPE_ARP);
+    memcpy(&r[14], f + 14, 6);
+    put16(&r[14 + 6], 2);
+    memcpy(&r[14 + 8], server_mac, 6);
+    memcpy(&r[14 + 14], f + 14 + 24, 4);
+    memcpy(&r[14 + 18], f + 14 + 8, 6);
+    memcpy(&r[14 + 24], f + 14 + 14, 4);
+    rx.push_back(r);
+    frames_rx++;
+    bytes_rx += r.size();
+    return;
+  }
+
+  if (type != ETH_TYPE_IP || len < 14 + 20 + 8 || memcmp(f, server_mac, 6) != 0)
+    return;
+
+  const uint8_t* ip = f + 14;
+  const uint8_t* udp = ip + 20;
+  if (ip[0] != 0x45 || ip[9] != 17)
+    return;
+
+  uint16_t udp_len = get16(udp + 4);
+  if (udp_len < 8 || 14 + 20 + (uint32_t)udp_len > len)
+    return;
+
+  memcpy(client_mac, f + 6, 6);
+  memcpy(client_ip, ip + 12, 4);
+  memcpy(server_ip, ip + 16, 4);
+  client_port = get16(udp);
+
+  uint16_t port = get16(udp + 2);
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port == 69 ? tftp_port : port);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  sendto(sock, udp + 8, udp_len - 8, 0, (struct sockaddr*)&addr, sizeof(addr));
+}
+
+void eth_model_t::poll()
+{
+  // all receive buffers are taken
+  if (rx.size() >= ETH_RX_BUFFERS)
+    return;
+
+  uint8_t payload[ETH_BUFFER_SIZE];
+  struct sockaddr_in addr;
+  socklen_t addr_len = sizeof(addr);
+  ssize_t n = recvfrom(sock, payload, sizeof(payload), 0,
+                       (struct sockaddr*)&addr, &addr_len);
+  if (n < 0 || n > ETH_BUFFER_SIZE - 14 - 20 - 8)
+    return;
+
+  // the reply comes from the server's transfer port, hand that to the
+  // bootrom unchanged
+  udp_frame(payload, n, ntohs(addr.sin_port));
+}
+
+void eth_model_t::udp_frame(const uint8_t* payload, uint32_t len, uint16_t src_port)
+{
+  std::vector<uint8_t> f(14 + 20 + 8 + len, 0);
+  uint8_t* ip = &f[14];
+  uint8_t* udp = ip + 20;
+
+  memcpy(&f[0], client_mac, 6);
+  memcpy(&f[6], server_mac, 6);
+  put16(&f[12], ETH_TYPE_IP);
+
+  ip[0] = 0x45;
+  put16(ip + 2, 20 + 8 + len);
+  ip[8] = 64;
+  ip[9] = 17;
+  memcpy(ip + 12, server_ip, 4);
+  memcpy(ip + 16, client_ip, 4);
+  uint32_t sum = 0;
+  for (int i = 0; i < 20; i += 2)
+    sum += get16(ip + i);
+  while (sum >> 16)
+    sum = (sum & 0xffff) + (sum >> 16);
+  put16(ip + 10, ~sum);
+
+  put16(udp, src_port);
+  put16(udp + 2, client_port);
+  put16(udp + 4, 8 + len);
+  memcpy(udp + 8, payload, len);
+
+  if (f.size() < 60)
+    f.resize(60, 0);
+
+  rx.push_back(f);
+  frames_rx++;
+  bytes_rx += f.size();
+}
@@ -0,0 +1,53 @@
+// Description: Register model of the lowRISC Ethernet MAC (framing_top) for
+//              the host side bootrom harness. The "network" answers ARP
+//              requests itself and forwards UDP payloads to servers on the
+//              loopback interface (e.g.: tftp_server.py).
+
+#ifndef ETH_MODEL_H
+#define ETH_MODEL_H
+
+#include <stdint.h>
+#include <deque>
+#include <vector>
+
+class eth_model_t
+{
+public:
+  // UDP datagrams for port 69 (TFTP) go to `tftp_port` on localhost, all
+  // others keep their destination port
+  eth_model_t(uint16_t tftp_port, uint64_t byte_ns);
+  ~eth_model_t();
+
+  uint64_t read(uint32_t offset, uint64_t now);
+  void write(uint32_t offset, uint64_t value, uint64_t now);
+
+  // statistics
+  uint64_t frames_tx;
+  uint64_t frames_rx;
+  uint64_t bytes_tx;
+  uint64_t bytes_rx;
+
+ private:
+  void transmit(uint32_t len);
+  void poll();
+  void udp_frame(const uint8_t* payload, uint32_t len, uint16_t src_port);
+
+  uint16_t tftp_port;
+  uint64_t byte_ns;
+  int sock;
+
+  uint8_t mac[6];
+  uint8_t txbuff[0x800];
+  uint64_t tx_busy_until;
+  // received frames, the front one sits in receive buffer `first`
+  std::deque<std::vector<uint8_t> > rx;
+  uint32_t first;
+
+  // learned from the frames the bootrom sends
+  uint8_t client_mac[6];
+  uint8_t client_ip[4];
+  uint8_t server_ip[4];
+  uint16_t client_port;
+};
+
+#endif
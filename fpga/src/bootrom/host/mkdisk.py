@@ -0,0 +1,87 @@
+#!/usr/bin/env python3
+
+# Build an SD card image with a GPT for the host side bootrom harness: a
+# small Linux partition followed by the boot partition (ONIE type GUID) which
+# holds the boot image, e.g. bbl.bin or the output of mkbootimg.py.
+
+import argparse
+import struct
+import sys
+import uuid
+import zlib
+
+BLOCK_SIZE = 512
+NR_ENTRIES = 128
+ENTRY_SIZE = 128
+ENTRY_BLOCKS = NR_ENTRIES * ENTRY_SIZE // BLOCK_SIZE
+
+ONIE_GUID = "7412f7d5-a156-4b13-81dc-867174929325"
+LINUX_GUID = "0fc63daf-8483-4772-8e79-3d69d8477de4"
+
+parser = argparse.ArgumentParser(description='Build a GPT disk image with a boot partition')
+parser.add_argument('image', help='boot image to put into the boot partition')
+parser.add_argument('output', help='disk image')
+parser.add_argument('--size', type=int, default=32, help='disk size in MiB')
+parser.add_argument('--boot-start', type=int, default=2048, help='first block of the boot partition')
+parser.add_argument('--boot-blocks', type=int, default=0,
+                    help='size of the boot partition in blocks (default: up to the backup GPT)')
+parser.add_argument('--name', default='bootloader', help='name of the boot partition')
+parser.add_argument('--corrupt', choices=['primary-header', 'primary-entries', 'backup-entries'],
+                    action='append', default=[], help='damage a GPT structure')
+
+args = parser.parse_args()
+
+with open(args.image, "rb") as f:
+    payload = f.read()
+
+nr_blocks = args.size * 1024 * 1024 // BLOCK_SIZE
+last_usable = nr_blocks - 2 - ENTRY_BLOCKS
+boot_first = args.boot_start
+boot_last = boot_first + args.boot_blocks - 1 if args.boot_blocks else last_usable
+
+if boot_last > last_usable or len(payload) > (boot_last - boot_first + 1) * BLOCK_SIZE:
+    print("{} does not fit into the boot partition".format(args.image))
+    sys.exit(1)
+
+disk = bytearray(nr_blocks * BLOCK_SIZE)
+
+def entry(type_guid, first, last, name):
+    return (uuid.UUID(type_guid).bytes_le + uuid.uuid4().bytes_le +
+            struct.pack("<QQQ", first, last, 0) + name.encode('utf-16-le').ljust(72, b"\0"))
+
+entries = bytearray(NR_ENTRIES * ENTRY_SIZE)
+entries[0:ENTRY_SIZE] = entry(LINUX_GUID, 34, boot_first - 1, "rootfs")
+entries[ENTRY_SIZE:2 * ENTRY_SIZE] = entry(ONIE_GUID, boot_first, boot_last, args.name)
+entries_crc = zlib.crc32(entries) & 0xffffffff
+disk_guid = uuid.uuid4().bytes_le
+
+def header(current, backup, entries_lba):
+    fmt = "<8sIIIIQQQQ16sQIII"
+    fields = [b"EFI PART", 0x10000, 92, 0, 0, current, backup, 34, last_usable,
+              disk_guid, entries_lba, NR_ENTRIES, ENTRY_SIZE, entries_crc]
+    fields[3] = zlib.crc32(struct.pack(fmt, *fields)) & 0xffffffff
+    return struct.pack(fmt, *fields)
+
+def put(lba, data):
+    disk[lba * BLOCK_SIZE:lba * BLOCK_SIZE + len(data)] = data
+
+# protective MBR
+put(0, bytes(446) + struct.pack("<B3sB3sII", 0, b"\x00\x02\x00", 0xee, b"\xff\xff\xff",
+                                1, min(nr_blocks - 1, 0xffffffff)))
+disk[510:512] = b"\x55\xaa"
+
+put(1, header(1, nr_blocks - 1, 2))
+put(2, entries)
+put(nr_blocks - 1 - ENTRY_BLOCKS, entries)
+put(nr_blocks - 1, header(nr_blocks - 1, 1, nr_blocks - 1 - ENTRY_BLOCKS))
+put(boot_first, payload)
+
+if 'primary-header' in args.corrupt:
+    disk[BLOCK_SIZE + 40] ^= 1
+if 'primary-entries' in args.corrupt:
+    disk[2 * BLOCK_SIZE + ENTRY_SIZE + 5] ^= 1
+if 'backup-entries' in args.corrupt:
+    disk[(nr_blocks - 1 - ENTRY_BLOCKS) * BLOCK_SIZE + ENTRY_SIZE + 5] ^= 1
+
+with open(args.output, "wb") as f:
+    f.write(disk)
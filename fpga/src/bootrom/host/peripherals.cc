@@ -0,0 +1,246 @@
+// Description: Register models of the AXI Quad SPI, the 16550 UART and the
+//              GPIO block for the host side bootrom harness
+
+#include <algorithm>
+#include <cstdio>
+
+#include "peripherals.h"
+
+#define SPI_FIFO_DEPTH 256
+
+#define SPI_SRR 0x40
+#define SPI_CR 0x60
+#define SPI_SR 0x64
+#define SPI_DTR 0x68
+#define SPI_DRR 0x6c
+#define SPI_SSR 0x70
+#define SPI_TX_OCY 0x74
+#define SPI_RX_OCY 0x78
+
+#define SPI_CR_SPE 0x002
+#define SPI_CR_MASTER 0x004
+#define SPI_CR_TX_RESET 0x020
+#define SPI_CR_RX_RESET 0x040
+#define SPI_CR_INHIBIT 0x100
+
+#define SPI_SR_RX_EMPTY 0x1
+#define SPI_SR_RX_FULL 0x2
+#define SPI_SR_TX_EMPTY 0x4
+#define SPI_SR_TX_FULL 0x8
+
+#define UART_FIFO_DEPTH 16
+
+#define UART_THR 0
+#define UART_LSR 5
+
+#define UART_LSR_THRE 0x20
+#define UART_LSR_TEMT 0x40
+
+uint32_t gpio_t::read(uint32_t offset)
+{
+  switch (offset) {
+    case 0x0: return 0; // the outputs are not read back, gpio_io_i is tied to 0
+    case 0x8: return switches;
+    default: return 0;
+  }
+}
+
+void gpio_t::write(uint32_t offset, uint32_t value)
+{
+  if (offset == 0x0)
+    out = value;
+}
+
+axi_quad_spi_t::axi_quad_spi_t(sd_card_t* card, gpio_t* gpio, uint64_t slow_ns, uint64_t fast_ns) :
+  bytes_slow(0),
+  bytes_fast(0),
+  busy_ns(0),
+  tx_overruns(0),
+  rx_overruns(0),
+  rx_underruns(0),
+  card(card),
+  gpio(gpio),
+  slow_ns(slow_ns),
+  fast_ns(fast_ns),
+  shifting(false),
+  shift_data(0),
+  shift_fast(false),
+  shift_done(0),
+  last_done(0)
+{
+  reset();
+}
+
+void axi_quad_spi_t::reset()
+{
+  cr = 0x180;
+  ssr = 0xffffffff;
+  tx.clear();
+  rx.clear();
+}
+
+bool axi_quad_spi_t::enabled()
+{
+  return (cr & (SPI_CR_SPE | SPI_CR_MASTER | SPI_CR_INHIBIT)) == (SPI_CR_SPE | SPI_CR_MASTER);
+}
+
+void axi_quad_spi_t::advance(uint64_t now)
+{
+  for (;;) {
+    if (!shifting) {
+      // a byte which is already on the wire finishes even if the
+      // transaction gets inhibited in the meantime
+      if (tx.empty() || !enabled())
+        return;
+      uint64_t start = std::max(last_done, tx.front().written);
+      if (start > now)
+        return;
+      shift_data = tx.front().data;
+      tx.pop_front();
+      shift_fast = gpio->spi_fast();
+      shift_done = start + (shift_fast ? fast_ns : slow_ns);
+      busy_ns += shift_done - start;
+      shifting = true;
+    }
+
+    if (shift_done > now)
+      return;
+
+    uint8_t miso = card->transfer(shift_data, shift_fast);
+    if (rx.size() < SPI_FIFO_DEPTH)
+      rx.push_back(miso);
+    else
+      rx_overruns++;
+    if (shift_fast)
+      bytes_fast++;
+    else
+      bytes_slow++;
+    last_done = shift_done;
+    shifting = false;
+  }
+}
+
+uint32_t axi_quad_spi_t::read(uint32_t offset, uint64_t now)
+{
+  advance(now);
+
+  uint32_t value;
+  switch (offset) {
+    case SPI_CR:
+      return cr;
+    case SPI_SR:
+      return (rx.empty() ? SPI_SR_RX_EMPTY : 0) |
+             (rx.size() == SPI_FIFO_DEPTH ? SPI_SR_RX_FULL : 0) |
+             (tx.empty() ? SPI_SR_TX_EMPTY : 0) |
+             (tx.size() == SPI_FIFO_DEPTH ? SPI_SR_TX_FULL : 0);
+    case SPI_DRR:
+      if (rx.empty()) {
+        rx_underruns++;
+        return 0;
+      }
+      value = rx.front();
+      rx.pop_front();
+      return value;
+    case SPI_SSR:
+      return ssr;
+    case SPI_TX_OCY:
+      return tx.empty() ? 0 : tx.size() - 1;
+    case SPI_RX_OCY:
+      return rx.empty() ? 0 : rx.size() - 1;
+    default:
+      return 0;
+  }
+}
+
+void axi_quad_spi_t::write(uint32_t offset, uint32_t value, uint64_t now)
+{
+  advance(now);
+
+  switch (offset) {
+    case SPI_SRR:
+      if (value == 0xa)
+        reset();
+      break;
+    case SPI_CR:
+      if (value & SPI_CR_TX_RESET)
+        tx.clear();
+      if (value & SPI_CR_RX_RESET)
+        rx.clear();
+      cr = value & ~(SPI_CR_TX_RESET | SPI_CR_RX_RESET);
+      break;
+    case SPI_DTR:
+      if (tx.size() < SPI_FIFO_DEPTH) {
+        tx_entry_t e;
+        e.data = value;
+        e.written = now;
+        tx.push_back(e);
+      } else {
+        tx_overruns++;
+      }
+      break;
+    case SPI_SSR:
+      ssr = value;
+      break;
+    default:
+      break;
+  }
+
+  // the transfer might start right away
+  advance(now);
+}
+
+uart_t::uart_t(uint64_t char_ns, bool echo) :
+  chars(0),
+  overruns(0),
+  char_ns(char_ns),
+  echo(echo),
+  last_done(0)
+{
+  for (int i = 0; i < 8; i++)
+    regs[i] = 0;
+}
+
+void uart_t::advance(uint64_t now)
+{
+  while (!tx.empty() && tx.front() <= now)
+    tx.pop_front();
+}
+
+uint32_t uart_t::read(uint32_t offset, uint64_t now)
+{
+  advance(now);
+
+  unsigned reg = (offset >> 2) & 0x7;
+  if (reg == UART_LSR)
+    // the FIFO is empty once at most the shift register is busy
+    return (tx.size() <= 1 ? UART_LSR_THRE : 0) | (tx.empty() ? UART_LSR_TEMT : 0);
+  return regs[reg];
+}
+
+void uart_t::write(uint32_t offset, uint32_t value, uint64_t now)
+{
+  advance(now);
+
+  unsigned reg = (offset >> 2) & 0x7;
+  if (reg != UART_THR) {
+    regs[reg] = value;
+    return;
+  }
+
+  // the divisor latch shares the address of the transmit holding register
+  if (regs[3] & 0x80)
+    return;
+
+  if (tx.size() > UART_FIFO_DEPTH) {
+    overruns++;
+    return;
+  }
+
+  last_done = std::max(last_done, now) + char_ns;
+  tx.push_back(last_done);
+  chars++;
+  if (echo) {
+    putchar(value & 0xff);
+    fflush(stdout);
+  }
+}
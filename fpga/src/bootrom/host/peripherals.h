@@ -0,0 +1,102 @@
+// Description: Register models of the AXI Quad SPI, the 16550 UART and the
+//              GPIO block for the host side bootrom harness. All timing is in
+//              nanoseconds of model time.
+
+#ifndef PERIPHERALS_H
+#define PERIPHERALS_H
+
+#include <stdint.h>
+#include <deque>
+
+#include "sd_card.h"
+
+class gpio_t
+{
+public:
+  gpio_t(uint32_t switches) : out(0), switches(switches) {}
+
+  uint32_t read(uint32_t offset);
+  void write(uint32_t offset, uint32_t value);
+
+  // bit 8 of the first channel selects the fast SPI clock
+  bool spi_fast() {return out & 0x100;}
+
+ private:
+  uint32_t out; // LEDs and SPI clock select
+  uint32_t switches;
+};
+
+// Xilinx AXI Quad SPI (standard mode, FIFO depth 256, C_SCK_RATIO 4)
+class axi_quad_spi_t
+{
+public:
+  axi_quad_spi_t(sd_card_t* card, gpio_t* gpio, uint64_t slow_ns, uint64_t fast_ns);
+
+  uint32_t read(uint32_t offset, uint64_t now);
+  void write(uint32_t offset, uint32_t value, uint64_t now);
+
+  // statistics
+  uint64_t bytes_slow;
+  uint64_t bytes_fast;
+  uint64_t busy_ns;
+  uint64_t tx_overruns;
+  uint64_t rx_overruns;
+  uint64_t rx_underruns;
+
+ private:
+  // run the shifter up to `now`
+  void advance(uint64_t now);
+  void reset();
+  bool enabled();
+
+  struct tx_entry_t {
+    uint8_t data;
+    uint64_t written;
+  };
+
+  sd_card_t* card;
+  gpio_t* gpio;
+  uint64_t slow_ns;
+  uint64_t fast_ns;
+
+  uint32_t cr;
+  uint32_t ssr;
+  std::deque<tx_entry_t> tx;
+  std::deque<uint8_t> rx;
+  // byte currently on the wire
+  bool shifting;
+  uint8_t shift_data;
+  bool shift_fast;
+  uint64_t shift_done;
+  uint64_t last_done;
+};
+
+// 16550 compatible UART, characters are printed when they are written to
+// the transmit holding register
+class uart_t
+{
+public:
+  uart_t(uint64_t char_ns, bool echo);
+
+  uint32_t read(uint32_t offset, uint64_t now);
+  void write(uint32_t offset, uint32_t value, uint64_t now);
+
+  // time when the last character has left the shift register
+  uint64_t idle_at() {return last_done;}
+
+  // statistics
+  uint64_t chars;
+  uint64_t overruns;
+
+ private:
+  void advance(uint64_t now);
+
+  uint64_t char_ns;
+  bool echo;
+  uint32_t regs[8];
+  // completion times of the characters in the FIFO and the shift register
+  std::deque<uint64_t> tx;
+  uint64_t last_done;
+};
+
+#endif
@@ -0,0 +1,80 @@
+#!/usr/bin/env python3
+
+# Boot the host side harness against a set of SD card images (plain, with an
+# image header, LZ4 compressed, CRC errors, damaged GPTs) and over the
+# network, and check that the payload ends up in memory. Prints the model
+# time of every run so that bootloader changes can be compared.
+
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+HOST = os.path.dirname(os.path.abspath(__file__))
+BOOTROM = os.path.dirname(HOST)
+
+harness = os.path.abspath(sys.argv[1] if len(sys.argv) > 1 else os.path.join(HOST, "bootrom_host"))
+tmp = tempfile.mkdtemp(prefix="bootrom_host.")
+
+def path(name):
+    return os.path.join(tmp, name)
+
+def run(cmd):
+    subprocess.run(cmd, check=True, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+
+def mkdisk(image, disk, *args):
+    run([sys.executable, os.path.join(HOST, "mkdisk.py"), path(image), path(disk), "--size", "8"] + list(args))
+
+failed = 0
+
+def boot(name, args, expect_success=True):
+    global failed
+    p = subprocess.run([harness, "-q", "-e", path("payload.bin")] + args,
+                       stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, universal_newlines=True)
+    m = re.search(r"model time: +([0-9.]+) ms", p.stderr)
+    ok = (p.returncode == 0) == expect_success
+    print("{:<28} {:<4} {:>10} ms".format(name, "ok" if ok else "FAIL", m.group(1) if m else "-"))
+    if not ok:
+        print(p.stderr)
+        failed += 1
+
+# not too compressible, with a size which is no multiple of the block size
+with open(path("payload.bin"), "wb") as f:
+    f.write(bytes(((i * 7) ^ (i >> 9) ^ (i >> 13)) & 0xff for i in range(300001)))
+
+run([sys.executable, os.path.join(BOOTROM, "mkbootimg.py"), path("payload.bin"), path("header.bin")])
+mkdisk("payload.bin", "raw.img", "--boot-blocks", "640")
+mkdisk("header.bin", "header.img")
+mkdisk("header.bin", "backup.img", "--corrupt", "primary-header")
+mkdisk("header.bin", "broken.img", "--corrupt", "primary-entries", "--corrupt", "backup-entries")
+
+boot("raw partition", ["-s", path("raw.img")])
+boot("image header", ["-s", path("header.img")])
+boot("image header, crc retry", ["-s", path("header.img"), "-c", "2100"])
+boot("backup gpt", ["-s", path("backup.img")])
+boot("no valid gpt", ["-s", path("broken.img")], expect_success=False)
+boot("no sd card", [], expect_success=False)
+
+if shutil.which("lz4"):
+    run([sys.executable, os.path.join(BOOTROM, "mkbootimg.py"), "--lz4", path("payload.bin"), path("lz4.bin")])
+    mkdisk("lz4.bin", "lz4.img")
+    boot("lz4", ["-s", path("lz4.img")])
+    boot("lz4, crc retry", ["-s", path("lz4.img"), "-c", "2060"])
+else:
+    print("lz4 not found, skipping the compressed images")
+
+os.mkdir(path("tftp"))
+shutil.copy(path("payload.bin"), os.path.join(tmp, "tftp", "bbl.bin"))
+port = 20000 + os.getpid() % 10000
+server = subprocess.Popen([sys.executable, os.path.join(BOOTROM, "tftp_server.py"), path("tftp"),
+                           "--address", "127.0.0.1", "--port", str(port), "--once"],
+                          stdout=subprocess.DEVNULL)
+time.sleep(0.5)
+boot("netboot", ["-d", "0x80", "-t", str(port)])
+server.kill()
+
+shutil.rmtree(tmp)
+sys.exit(1 if failed else 0)
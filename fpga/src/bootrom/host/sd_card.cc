@@ -0,0 +1,215 @@
+// Description: SD card in SPI mode backed by a disk image, for the host side
+//              bootrom harness
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <cstdio>
+
+#include "sd_card.h"
+
+#define SD_BLOCK_SIZE 512
+#define SD_DATA_TOKEN 0xfe
+#define SD_ERROR_TOKEN_OUT_OF_RANGE 0x08
+
+#define R1_IDLE 0x01
+#define R1_ILLEGAL_COMMAND 0x04
+#define R1_ADDRESS_ERROR 0x20
+
+static uint16_t crc16(const uint8_t* data, size_t len)
+{
+  uint16_t crc = 0;
+  for (size_t i = 0; i < len; i++) {
+    crc ^= (uint16_t)data[i] << 8;
+    for (int j = 0; j < 8; j++)
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+  }
+  return crc;
+}
+
+sd_card_t::sd_card_t(const char* filename) :
+  blocks_read(0),
+  crc_errors_injected(0),
+  image(NULL),
+  size(0),
+  nr_blocks(0),
+  cmd_len(0),
+  idle(true),
+  app_cmd(false),
+  acmd41_polls(0),
+  reading(false),
+  single_block(false),
+  read_lba(0),
+  nac(8),
+  init_polls(2),
+  corrupt_lba(-1),
+  fast(false)
+{
+  memset(commands, 0, sizeof(commands));
+
+  if (!filename)
+    return;
+
+  int fd = open(filename, O_RDONLY);
+  struct stat s;
+  if (fd == -1 || fstat(fd, &s) < 0) {
+    fprintf(stderr, "sd_card failed to open %s: %s (%d)\n",
+            filename, strerror(errno), errno);
+    abort();
+  }
+
+  size = s.st_size;
+  nr_blocks = size / SD_BLOCK_SIZE;
+  if (size) {
+    image = (uint8_t*) mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (image == MAP_FAILED) {
+      fprintf(stderr, "sd_card failed to map %s: %s (%d)\n",
+              filename, strerror(errno), errno);
+      abort();
+    }
+  }
+  close(fd);
+}
+
+sd_card_t::~sd_card_t()
+{
+  if (image)
+    munmap(image, size);
+}
+
+uint8_t sd_card_t::transfer(uint8_t mosi, bool fast)
+{
+  this->fast = fast;
+
+  if (!image)
+    return 0xff;
+
+  // card output
+  if (out.empty() && reading)
+    queue_block();
+
+  uint8_t miso = 0xff;
+  if (!out.empty()) {
+    miso = out.front();
+    out.pop_front();
+  }
+
+  // card input, commands start with 01b and are always 6 bytes long (the
+  // host keeps sending 0xff while it receives)
+  if (cmd_len == 0) {
+    if ((mosi & 0xc0) == 0x40)
+      cmd[cmd_len++] = mosi;
+  } else {
+    cmd[cmd_len++] = mosi;
+    if (cmd_len == 6) {
+      execute();
+      cmd_len = 0;
+    }
+  }
+
+  return miso;
+}
+
+void sd_card_t::execute()
+{
+  uint8_t index = cmd[0] & 0x3f;
+  uint32_t arg = ((uint32_t)cmd[1] << 24) | (cmd[2] << 16) | (cmd[3] << 8) | cmd[4];
+  bool acmd = app_cmd;
+
+  commands[index]++;
+  app_cmd = false;
+
+  // a new command aborts whatever the card was sending, the response
+  // follows after one byte (NCR)
+  out.clear();
+  out.push_back(0xff);
+
+  uint8_t r1 = idle ? R1_IDLE : 0;
+
+  switch (index) {
+    case 0:
+      idle = true;
+      reading = false;
+      acmd41_polls = 0;
+      out.push_back(R1_IDLE);
+      break;
+    case 8:
+      // R7: echo voltage and check pattern
+      out.push_back(r1);
+      out.push_back(0x00);
+      out.push_back(0x00);
+      out.push_back((arg >> 8) & 0xf);
+      out.push_back(arg & 0xff);
+      break;
+    case 12:
+      // the stuff byte has already been queued
+      reading = false;
+      out.push_back(r1);
+      break;
+    case 17:
+    case 18:
+      if (idle) {
+        out.push_back(r1 | R1_ILLEGAL_COMMAND);
+      } else if (arg >= nr_blocks) {
+        out.push_back(R1_ADDRESS_ERROR);
+      } else {
+        out.push_back(0x00);
+        reading = true;
+        single_block = index == 17;
+        read_lba = arg;
+      }
+      break;
+    case 41:
+      if (!acmd) {
+        out.push_back(r1 | R1_ILLEGAL_COMMAND);
+        break;
+      }
+      if (++acmd41_polls >= init_polls)
+        idle = false;
+      out.push_back(idle ? R1_IDLE : 0);
+      break;
+    case 55:
+      app_cmd = true;
+      out.push_back(r1);
+      break;
+    default:
+      out.push_back(r1 | R1_ILLEGAL_COMMAND);
+      break;
+  }
+}
+
+void sd_card_t::queue_block()
+{
+  if (read_lba >= nr_blocks) {
+    out.push_back(SD_ERROR_TOKEN_OUT_OF_RANGE);
+    reading = false;
+    return;
+  }
+
+  uint8_t block[SD_BLOCK_SIZE];
+  memcpy(block, image + read_lba * SD_BLOCK_SIZE, SD_BLOCK_SIZE);
+  uint16_t crc = crc16(block, SD_BLOCK_SIZE);
+
+  if ((int64_t)read_lba == corrupt_lba && fast) {
+    block[0] ^= 0x1;
+    corrupt_lba = -1;
+    crc_errors_injected++;
+  }
+
+  for (unsigned i = 0; i < nac; i++)
+    out.push_back(0xff);
+  out.push_back(SD_DATA_TOKEN);
+  out.insert(out.end(), block, block + SD_BLOCK_SIZE);
+  out.push_back(crc >> 8);
+  out.push_back(crc & 0xff);
+
+  blocks_read++;
+  read_lba++;
+  if (single_block)
+    reading = false;
+}
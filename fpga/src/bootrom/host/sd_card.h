@@ -0,0 +1,60 @@
+// Description: SD card in SPI mode backed by a disk image, for the host side
+//              bootrom harness
+
+#ifndef SD_CARD_H
+#define SD_CARD_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <deque>
+
+class sd_card_t
+{
+public:
+  // `filename` may be NULL: no card inserted, MISO stays high
+  sd_card_t(const char* filename);
+  ~sd_card_t();
+
+  // exchange one byte on the bus, `fast` tells whether the transfer clock
+  // is selected (used for fault injection)
+  uint8_t transfer(uint8_t mosi, bool fast);
+
+  // number of 0xff bytes before each data token of a multiple block read
+  void set_nac(unsigned nac) {this->nac = nac;}
+  // corrupt the first block at `lba` which is sent with the transfer clock
+  // (a block sent ahead and discarded after CMD12 counts as well)
+  void set_corrupt_lba(int64_t lba) {corrupt_lba = lba;}
+  // number of ACMD41 polls before the card leaves the idle state
+  void set_init_polls(unsigned polls) {init_polls = polls;}
+
+  // statistics
+  uint64_t commands[64];
+  uint64_t blocks_read;
+  uint64_t crc_errors_injected;
+
+ private:
+  void execute();
+  void queue_block();
+
+  uint8_t* image;
+  uint64_t size;
+  uint64_t nr_blocks;
+
+  std::deque<uint8_t> out;
+  uint8_t cmd[6];
+  int cmd_len;
+
+  bool idle;
+  bool app_cmd;
+  unsigned acmd41_polls;
+  bool reading;
+  bool single_block;
+  uint64_t read_lba;
+
+  unsigned nac;
+  unsigned init_polls;
+  int64_t corrupt_lba;
+  bool fast;
+};
+
+#endif
@@ -0,0 +1,48 @@
+#!/usr/bin/env python3
+
+# Prepend the boot image header expected by the bootloader to a payload
+# (e.g. bbl.bin). The header occupies the first block of the boot partition,
+# the bootloader then only copies the payload instead of the whole partition.
+# With --lz4 the payload gets compressed with the lz4 command line tool.
+
+import argparse
+import struct
+import subprocess
+import sys
+import zlib
+
+BLOCK_SIZE = 512
+BOOT_IMAGE_MAGIC = b"ABOOTIMG"
+BOOT_IMAGE_LZ4 = 0x1
+
+parser = argparse.ArgumentParser(description='Add a boot image header to a binary')
+parser.add_argument('input', help='raw payload (e.g. bbl.bin)')
+parser.add_argument('output', help='image to be written to the boot partition')
+parser.add_argument('--lz4', action='store_true',
+                   help='compress the payload (LZ4 frame with 64 KiB blocks)')
+
+args = parser.parse_args()
+
+with open(args.input, "rb") as f:
+    payload = f.read()
+
+if len(payload) == 0:
+    print("{} is empty".format(args.input))
+    sys.exit(1)
+
+crc = zlib.crc32(payload) & 0xffffffff
+load_size = len(payload)
+flags = 0
+
+if args.lz4:
+    # the bootloader stages at most one 64 KiB block (-B4) at a time
+    payload = subprocess.run(["lz4", "-9", "-B4", "-c", args.input],
+                             stdout=subprocess.PIPE, check=True).stdout
+    flags |= BOOT_IMAGE_LZ4
+
+header = BOOT_IMAGE_MAGIC + struct.pack("<QIIQ", len(payload), crc, flags, load_size)
+header += b"\0" * (BLOCK_SIZE - len(header))
+
+with open(args.output, "wb") as f:
+    f.write(header)
+    f.write(payload)
@@ -1,2 +1,27 @@
+#pragma once
+
+#include <stdint.h>
+
 #define DRAM_BASE 0x80000000
-#define DRAM_SIZE 0x4000000
\ No newline at end of file
+#define DRAM_SIZE 0x4000000
+
+// GPIO channel 1: LEDs and SPI clock select, channel 2: DIP switches
+#define GPIO_BASE 0x40000000
+#define GPIO_DATA_REG GPIO_BASE + 0x0
+#define GPIO2_DATA_REG GPIO_BASE + 0x8
+
+// keep the top of DRAM free for the stack of the bootloader (see startup.S)
+#define STACK_SIZE 0x10000
+
+// there is no writable data section, the value driven onto the first GPIO
+// channel and the UART transmit ring live at the bottom of the stack region
+#define GPIO_SHADOW_BASE (DRAM_BASE + DRAM_SIZE - STACK_SIZE)
+#define UART_RING_BASE (GPIO_SHADOW_BASE + 8)
+
+#ifdef BOOTROM_HOST
+// built for the host side harness (host/), all peripheral accesses go to its
+// models and DRAM is mapped at DRAM_BASE in the host process
+uint64_t host_mmio_read(uintptr_t addr, int size);
+void host_mmio_write(uintptr_t addr, uint64_t value, int size);
+uint64_t host_cycle();
+#endif
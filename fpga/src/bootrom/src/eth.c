@@ -0,0 +1,84 @@
+#include "eth.h"
+
+// the MAC only supports 64-bit accesses
+static void eth_write(uintptr_t addr, uint64_t value)
+{
+#ifdef BOOTROM_HOST
+    host_mmio_write(addr, value, 8);
+#else
+    *(volatile uint64_t *)addr = value;
+#endif
+}
+
+static uint64_t eth_read(uintptr_t addr)
+{
+#ifdef BOOTROM_HOST
+    return host_mmio_read(addr, 8);
+#else
+    return *(volatile uint64_t *)addr;
+#endif
+}
+
+void eth_init(const uint8_t mac[6])
+{
+    // only accept frames for our address (and broadcasts), no interrupts
+    eth_write(ETH_MACLO_REG, ((uint32_t)mac[2] << 24) | (mac[3] << 16) | (mac[4] << 8) | mac[5]);
+    eth_write(ETH_MACHI_REG, (mac[0] << 8) | mac[1]);
+
+    // drop everything which has been received so far
+    while (eth_read(ETH_RSR_REG) & ETH_RSR_DONE_MASK)
+        eth_write(ETH_RSR_REG, (eth_read(ETH_RSR_REG) & ETH_RSR_FIRST_MASK) + 1);
+}
+
+void eth_send(const uint8_t *frame, uint32_t len)
+{
+    uint32_t i;
+
+    // wait for the previous frame to leave
+    while (eth_read(ETH_TPLR_REG) & ETH_TPLR_BUSY_MASK)
+        ;
+
+    if (len > ETH_FRAME_MAX)
+        len = ETH_FRAME_MAX;
+
+    for (i = 0; i < len; i += 8)
+    {
+        uint64_t word = 0;
+        for (int j = 0; j < 8; j++)
+        {
+            if (i + j < len)
+                word |= (uint64_t)frame[i + j] << (j * 8);
+        }
+        eth_write(ETH_TXBUFF + i, word);
+    }
+    for (; i < ETH_FRAME_MIN; i += 8)
+        eth_write(ETH_TXBUFF + i, 0);
+
+    eth_write(ETH_TPLR_REG, len < ETH_FRAME_MIN ? ETH_FRAME_MIN : len);
+}
+
+uint32_t eth_recv(uint8_t *frame)
+{
+    uint64_t rsr = eth_read(ETH_RSR_REG);
+
+    if ((rsr & ETH_RSR_DONE_MASK) == 0)
+        return 0;
+
+    uint32_t buf = rsr & ETH_RSR_FIRST_MASK;
+    uintptr_t base = ETH_RXBUFF + (buf % ETH_RX_BUFFERS) * ETH_RX_BUFFER_SIZE;
+    uint32_t len = eth_read(ETH_RPLR_REG + (buf % ETH_RX_BUFFERS) * 8) & ETH_RPLR_LENGTH_MASK;
+
+    if (len > ETH_FRAME_MAX)
+        len = ETH_FRAME_MAX;
+
+    for (uint32_t i = 0; i < len; i += 8)
+    {
+        uint64_t word = eth_read(base + i);
+        for (int j = 0; j < 8 && i + j < len; j++)
+            frame[i + j] = word >> (j * 8);
+    }
+
+    // hand the buffer back to the MAC
+    eth_write(ETH_RSR_REG, buf + 1);
+    return len;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <stdint.h>
+#include "platform.h"
+
+// lowRISC Ethernet MAC (framing_top)
+#define ETH_BASE 0x30000000
+
+#define ETH_MACLO_REG ETH_BASE + 0x0800
+#define ETH_MACHI_REG ETH_BASE + 0x0808
+#define ETH_TPLR_REG ETH_BASE + 0x0810 // transmit packet length
+#define ETH_RSR_REG ETH_BASE + 0x0830  // receive status
+#define ETH_RPLR_REG ETH_BASE + 0x0840 // receive packet length, one per buffer
+#define ETH_TXBUFF ETH_BASE + 0x1000
+#define ETH_RXBUFF ETH_BASE + 0x4000
+
+#define ETH_RSR_FIRST_MASK 0xf
+#define ETH_RSR_DONE_MASK 0x1000
+#define ETH_RPLR_LENGTH_MASK 0xfff
+#define ETH_TPLR_BUSY_MASK 0x80000000
+
+#define ETH_RX_BUFFERS 8
+#define ETH_RX_BUFFER_SIZE 0x800
+#define ETH_FRAME_MIN 60
+#define ETH_FRAME_MAX 1536
+
+void eth_init(const uint8_t mac[6]);
+
+// send a frame, short frames get padded
+void eth_send(const uint8_t *frame, uint32_t len);
+
+// copy the next received frame (at most ETH_FRAME_MAX bytes) into frame,
+// returns its length or 0 if nothing has been received
+uint32_t eth_recv(uint8_t *frame);
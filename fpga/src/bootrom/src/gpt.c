@@ -2,61 +2,282 @@
 
 #include "sd.h"
 #include "uart.h"
+#include "lz4.h"
 #include <stddef.h>
 
-int gpt_find_boot_partition(uint8_t* dest, uint32_t size)
+static const uint32_t crc32_table[256] = {
+    0x00000000, 0x77073096, 0xee0e612c, 0x990951ba, 0x076dc419, 0x706af48f,
+    0xe963a535, 0x9e6495a3, 0x0edb8832, 0x79dcb8a4, 0xe0d5e91e, 0x97d2d988,
+    0x09b64c2b, 0x7eb17cbd, 0xe7b82d07, 0x90bf1d91, 0x1db71064, 0x6ab020f2,
+    0xf3b97148, 0x84be41de, 0x1adad47d, 0x6ddde4eb, 0xf4d4b551, 0x83d385c7,
+    0x136c9856, 0x646ba8c0, 0xfd62f97a, 0x8a65c9ec, 0x14015c4f, 0x63066cd9,
+    0xfa0f3d63, 0x8d080df5, 0x3b6e20c8, 0x4c69105e, 0xd56041e4, 0xa2677172,
+    0x3c03e4d1, 0x4b04d447, 0xd20d85fd, 0xa50ab56b, 0x35b5a8fa, 0x42b2986c,
+    0xdbbbc9d6, 0xacbcf940, 0x32d86ce3, 0x45df5c75, 0xdcd60dcf, 0xabd13d59,
+    0x26d930ac, 0x51de003a, 0xc8d75180, 0xbfd06116, 0x21b4f4b5, 0x56b3c423,
+    0xcfba9599, 0xb8bda50f, 0x2802b89e, 0x5f058808, 0xc60cd9b2, 0xb10be924,
+    0x2f6f7c87, 0x58684c11, 0xc1611dab, 0xb6662d3d, 0x76dc4190, 0x01db7106,
+    0x98d220bc, 0xefd5102a, 0x71b18589, 0x06b6b51f, 0x9fbfe4a5, 0xe8b8d433,
+    0x7807c9a2, 0x0f00f934, 0x9609a88e, 0xe10e9818, 0x7f6a0dbb, 0x086d3d2d,
+    0x91646c97, 0xe6635c01, 0x6b6b51f4, 0x1c6c6162, 0x856530d8, 0xf262004e,
+    0x6c0695ed, 0x1b01a57b, 0x8208f4c1, 0xf50fc457, 0x65b0d9c6, 0x12b7e950,
+    0x8bbeb8ea, 0xfcb9887c, 0x62dd1ddf, 0x15da2d49, 0x8cd37cf3, 0xfbd44c65,
+    0x4db26158, 0x3ab551ce, 0xa3bc0074, 0xd4bb30e2, 0x4adfa541, 0x3dd895d7,
+    0xa4d1c46d, 0xd3d6f4fb, 0x4369e96a, 0x346ed9fc, 0xad678846, 0xda60b8d0,
+    0x44042d73, 0x33031de5, 0xaa0a4c5f, 0xdd0d7cc9, 0x5005713c, 0x270241aa,
+    0xbe0b1010, 0xc90c2086, 0x5768b525, 0x206f85b3, 0xb966d409, 0xce61e49f,
+    0x5edef90e, 0x29d9c998, 0xb0d09822, 0xc7d7a8b4, 0x59b33d17, 0x2eb40d81,
+    0xb7bd5c3b, 0xc0ba6cad, 0xedb88320, 0x9abfb3b6, 0x03b6e20c, 0x74b1d29a,
+    0xead54739, 0x9dd277af, 0x04db2615, 0x73dc1683, 0xe3630b12, 0x94643b84,
+    0x0d6d6a3e, 0x7a6a5aa8, 0xe40ecf0b, 0x9309ff9d, 0x0a00ae27, 0x7d079eb1,
+    0xf00f9344, 0x8708a3d2, 0x1e01f268, 0x6906c2fe, 0xf762575d, 0x806567cb,
+    0x196c3671, 0x6e6b06e7, 0xfed41b76, 0x89d32be0, 0x10da7a5a, 0x67dd4acc,
+    0xf9b9df6f, 0x8ebeeff9, 0x17b7be43, 0x60b08ed5, 0xd6d6a3e8, 0xa1d1937e,
+    0x38d8c2c4, 0x4fdff252, 0xd1bb67f1, 0xa6bc5767, 0x3fb506dd, 0x48b2364b,
+    0xd80d2bda, 0xaf0a1b4c, 0x36034af6, 0x41047a60, 0xdf60efc3, 0xa867df55,
+    0x316e8eef, 0x4669be79, 0xcb61b38c, 0xbc66831a, 0x256fd2a0, 0x5268e236,
+    0xcc0c7795, 0xbb0b4703, 0x220216b9, 0x5505262f, 0xc5ba3bbe, 0xb2bd0b28,
+    0x2bb45a92, 0x5cb36a04, 0xc2d7ffa7, 0xb5d0cf31, 0x2cd99e8b, 0x5bdeae1d,
+    0x9b64c2b0, 0xec63f226, 0x756aa39c, 0x026d930a, 0x9c0906a9, 0xeb0e363f,
+    0x72076785, 0x05005713, 0x95bf4a82, 0xe2b87a14, 0x7bb12bae, 0x0cb61b38,
+    0x92d28e9b, 0xe5d5be0d, 0x7cdcefb7, 0x0bdbdf21, 0x86d3d2d4, 0xf1d4e242,
+    0x68ddb3f8, 0x1fda836e, 0x81be16cd, 0xf6b9265b, 0x6fb077e1, 0x18b74777,
+    0x88085ae6, 0xff0f6a70, 0x66063bca, 0x11010b5c, 0x8f659eff, 0xf862ae69,
+    0x616bffd3, 0x166ccf45, 0xa00ae278, 0xd70dd2ee, 0x4e048354, 0x3903b3c2,
+    0xa7672661, 0xd06016f7, 0x4969474d, 0x3e6e77db, 0xaed16a4a, 0xd9d65adc,
+    0x40df0b66, 0x37d83bf0, 0xa9bcae53, 0xdebb9ec5, 0x47b2cf7f, 0x30b5ffe9,
+    0xbdbdf21c, 0xcabac28a, 0x53b39330, 0x24b4a3a6, 0xbad03605, 0xcdd70693,
+    0x54de5729, 0x23d967bf, 0xb3667a2e, 0xc4614ab8, 0x5d681b02, 0x2a6f2b94,
+    0xb40bbe37, 0xc30c8ea1, 0x5a05df1b, 0x2d02ef8d,
+};
+
+uint32_t crc32(uint32_t crc, const uint8_t *data, uint64_t len)
 {
-    int ret = init_sd();
-    if (ret != 0) {
-        print_uart("could not initialize sd... exiting\r\n");
+    crc = ~crc;
+    for (; len > 0; len--, data++)
+    {
+        crc = (crc >> 8) ^ crc32_table[(crc ^ *data) & 0xff];
+    }
+    return ~crc;
+}
+
+// the protective MBR covers the whole disk, it tells where the backup GPT is
+static uint64_t gpt_last_lba(uint8_t *buf)
+{
+    if (sd_copy(buf, 0, 1) != 0)
+        return 0;
+
+    mbr_partition_t *part = (mbr_partition_t *)(buf + MBR_PARTITION_OFFSET);
+    if (buf[510] != 0x55 || buf[511] != 0xaa || part->type != MBR_TYPE_PROTECTIVE)
+        return 0;
+
+    // the fields are not naturally aligned
+    uint32_t first = part->first_lba[0] | (part->first_lba[1] << 8) |
+                     (part->first_lba[2] << 16) | ((uint32_t)part->first_lba[3] << 24);
+    uint32_t nr = part->nr_lba[0] | (part->nr_lba[1] << 8) |
+                  (part->nr_lba[2] << 16) | ((uint32_t)part->nr_lba[3] << 24);
+    return (uint64_t)first + nr - 1;
+}
+
+// read the partition table header at lba and check signature and CRC
+static int gpt_read_header(uint64_t lba, uint8_t *buf)
+{
+    gpt_pth_t *header = (gpt_pth_t *)buf;
+
+    if (sd_copy(buf, lba, 1) != 0)
+        return -1;
+
+    if (header->signature != GPT_SIGNATURE ||
+        header->header_size < GPT_HEADER_SIZE || header->header_size > 512 ||
+        header->current_lba != lba)
+        return -1;
+
+    // the CRC is computed with the CRC field itself set to zero
+    uint32_t crc = header->crc_header;
+    header->crc_header = 0;
+    if (crc32(0, buf, header->header_size) != crc)
         return -1;
+    header->crc_header = crc;
+
+    // entries must not straddle blocks
+    if (header->size_partition_entry < sizeof(partition_entries_t) ||
+        512 % header->size_partition_entry != 0)
+        return -1;
+
+    return 0;
+}
+
+static int gpt_match_entry(partition_entries_t *entry)
+{
+    static const uint8_t boot_type[16] = BOOT_PARTITION_TYPE;
+
+    for (int i = 0; i < 16; i++)
+    {
+        if (entry->partition_type_guid[i] != boot_type[i])
+            return 0;
     }
 
-    print_uart("sd initialized!\r\n");
+#ifdef BOOT_PARTITION_NAME
+    // compare the UTF-16LE name against the ASCII name
+    const char *name = BOOT_PARTITION_NAME;
+    for (int i = 0; i < 36; i++)
+    {
+        if (entry->name[2 * i] != (uint8_t)name[i] || entry->name[2 * i + 1] != 0)
+            return 0;
+        if (name[i] == 0)
+            break;
+    }
+#endif
+    return 1;
+}
 
-    // load LBA1
-    size_t block_size = 512;
-    uint8_t lba1_buf[block_size];
+// Walk the whole partition entry array, returns 0 and the bounds of the boot
+// partition if it has been found and the array CRC matches.
+static int gpt_find_entry(gpt_pth_t *header, uint8_t *buf, uint64_t *first_lba, uint64_t *last_lba)
+{
+    sd_reader_t r;
+    uint64_t len = (uint64_t)header->nr_partition_entries * header->size_partition_entry;
+    uint32_t nr_blocks = (len + 511) / 512;
+    uint32_t crc = 0;
+    int found = 0;
+    int rc;
 
-    int res = sd_copy(lba1_buf, 1, 1);
+    if (nr_blocks == 0 || nr_blocks > GPT_MAX_ENTRY_BLOCKS)
+        return -1;
 
-    if (res != 0)
+    rc = sd_read_start(&r, header->partition_entries_lba);
+    if (rc == 0)
     {
-        print_uart("SD card failed!\r\n");
-        print_uart("sd copy return value: ");
-        print_uart_addr(res);
-        print_uart("\r\n");
+        for (uint32_t i = 0; i < nr_blocks; i++)
+        {
+            uint32_t n = len < 512 ? len : 512;
+
+            rc = sd_read_block(&r, buf, i + 1 < nr_blocks);
+            if (rc != 0)
+                break;
+
+            crc = crc32(crc, buf, n);
+            len -= n;
+
+            for (uint32_t j = 0; j < n && !found; j += header->size_partition_entry)
+            {
+                partition_entries_t *entry = (partition_entries_t *)(buf + j);
+                if (gpt_match_entry(entry))
+                {
+                    *first_lba = entry->first_lba;
+                    *last_lba = entry->last_lba;
+                    found = 1;
+                }
+            }
+        }
+        sd_read_stop(&r);
+    }
+
+    if (rc != 0 || crc != header->crc_partition_entry)
+    {
+        print_uart("gpt partition entries corrupt\r\n");
+        return -1;
+    }
+    if (!found)
+    {
+        print_uart("no boot partition\r\n");
         return -2;
     }
+    return 0;
+}
 
-    gpt_pth_t *lba1 = (gpt_pth_t *)lba1_buf;
+static void gpt_print_header(gpt_pth_t *header)
+{
+    if (VERBOSITY < VERBOSITY_DEBUG)
+        return;
 
     print_uart("gpt partition table header:");
-    print_uart("\r\n\tsignature:\t");
-    print_uart_addr(lba1->signature);
     print_uart("\r\n\trevision:\t");
-    print_uart_int(lba1->revision);
-    print_uart("\r\n\tsize:\t\t");
-    print_uart_int(lba1->header_size);
-    print_uart("\r\n\tcrc_header:\t");
-    print_uart_int(lba1->crc_header);
-    print_uart("\r\n\treserved:\t");
-    print_uart_int(lba1->reserved);
+    print_uart_int(header->revision);
     print_uart("\r\n\tcurrent lba:\t");
-    print_uart_addr(lba1->current_lba);
-    print_uart("\r\n\tbackup lda:\t");
-    print_uart_addr(lba1->backup_lba);
+    print_uart_addr(header->current_lba);
+    print_uart("\r\n\tbackup lba:\t");
+    print_uart_addr(header->backup_lba);
     print_uart("\r\n\tpartition entries lba:   \t");
-    print_uart_addr(lba1->partition_entries_lba);
+    print_uart_addr(header->partition_entries_lba);
     print_uart("\r\n\tnumber partition entries:\t");
-    print_uart_int(lba1->nr_partition_entries);
+    print_uart_int(header->nr_partition_entries);
     print_uart("\r\n\tsize partition entries:  \t");
-    print_uart_int(lba1->size_partition_entry);
+    print_uart_int(header->size_partition_entry);
     print_uart("\r\n");
+}
+
+int gpt_find_boot_partition(uint8_t* dest, uint32_t size)
+{
+    int ret = init_sd();
+    if (ret != 0) {
+        print_uart("could not initialize sd... exiting\r\n");
+        return -1;
+    }
 
-    uint8_t lba2_buf[block_size];
+    if (VERBOSITY >= VERBOSITY_INFO)
+        print_uart("sd initialized!\r\n");
 
-    res = sd_copy(lba2_buf, lba1->partition_entries_lba, 1);
+    size_t block_size = 512;
+    uint8_t header_buf[block_size];
+    uint8_t buf[block_size];
+    gpt_pth_t *header = (gpt_pth_t *)header_buf;
+    uint64_t first_lba = 0, last_lba = 0;
+    uint64_t backup_lba = 0;
+
+    // primary GPT at LBA1, its header also tells where the backup is
+    if (gpt_read_header(1, header_buf) == 0)
+    {
+        gpt_print_header(header);
+        backup_lba = header->backup_lba;
+        ret = gpt_find_entry(header, buf, &first_lba, &last_lba);
+    }
+    else
+    {
+        print_uart("primary gpt header corrupt\r\n");
+        backup_lba = gpt_last_lba(buf);
+        ret = -1;
+    }
+
+    // only a corrupt table is a reason to look at the backup
+    if (ret == -1)
+    {
+        if (backup_lba == 0 || gpt_read_header(backup_lba, header_buf) != 0)
+        {
+            print_uart("no valid gpt found\r\n");
+            return -2;
+        }
+        print_uart("using backup gpt\r\n");
+        gpt_print_header(header);
+        ret = gpt_find_entry(header, buf, &first_lba, &last_lba);
+    }
+
+    if (ret != 0)
+        return -2;
+
+    if (VERBOSITY >= VERBOSITY_INFO)
+    {
+        print_uart("boot partition: ");
+        print_uart_addr(first_lba);
+        print_uart(" - ");
+        print_uart_addr(last_lba);
+        print_uart("\r\n");
+    }
+
+    if (last_lba < first_lba)
+    {
+        print_uart("invalid boot partition\r\n");
+        return -3;
+    }
+
+    uint64_t nr_blocks = last_lba - first_lba + 1;
+    uint64_t image_size = 0;
+    uint64_t load_size = 0;
+    uint32_t image_crc = 0;
+    uint32_t image_flags = 0;
+
+    // check for an image header, it gives the exact size of the payload
+    int res = sd_copy(buf, first_lba, 1);
 
     if (res != 0)
     {
@@ -67,32 +288,65 @@ int gpt_find_boot_partition(uint8_t* dest, uint32_t size)
         return -2;
     }
 
-    for (int i = 0; i < 4; i++)
-    {
-        partition_entries_t *part_entry = (partition_entries_t *)(lba2_buf + (i * 128));
-        print_uart("gpt partition entry ");
-        print_uart_byte(i);
-        print_uart("\r\n\tpartition type guid:\t");
-        for (int j = 0; j < 16; j++)
-            print_uart_byte(part_entry->partition_type_guid[j]);
-        print_uart("\r\n\tpartition guid:     \t");
-        for (int j = 0; j < 16; j++)
-            print_uart_byte(part_entry->partition_guid[j]);
-        print_uart("\r\n\tfirst lba:\t");
-        print_uart_addr(part_entry->first_lba);
-        print_uart("\r\n\tlast lba:\t");
-        print_uart_addr(part_entry->last_lba);
-        print_uart("\r\n\tattributes:\t");
-        print_uart_addr(part_entry->attributes);
-        print_uart("\r\n\tname:\t");
-        for (int j = 0; j < 72; j++)
-            print_uart_byte(part_entry->name[j]);
-        print_uart("\r\n");
+    boot_image_header_t *image = (boot_image_header_t *)buf;
+
+    if (image->magic == BOOT_IMAGE_MAGIC)
+    {
+        image_size = image->size;
+        image_crc = image->crc;
+        image_flags = image->flags;
+        load_size = (image_flags & BOOT_IMAGE_LZ4) ? image->load_size : image_size;
+
+        if (image_size == 0 || image_size > (nr_blocks - 1) * block_size)
+        {
+            print_uart("boot image does not fit into the partition\r\n");
+            return -3;
+        }
+
+        first_lba++;
+        nr_blocks = (image_size + block_size - 1) / block_size;
     }
 
-    partition_entries_t *boot = (partition_entries_t *)(lba2_buf);
-    print_uart("copying boot image ");
-    res = sd_copy(dest, boot->first_lba, size);
+    if (image_flags & BOOT_IMAGE_LZ4)
+    {
+        // the compressed blocks are staged at the end of the destination
+        uint64_t capacity = (uint64_t)size * block_size - LZ4_STAGING_SIZE;
+        if (load_size > capacity)
+        {
+            print_uart("boot image too large: ");
+            print_uart_addr(load_size);
+            print_uart(" bytes\r\n");
+            return -3;
+        }
+
+        if (VERBOSITY >= VERBOSITY_INFO)
+        {
+            print_uart("copying compressed boot image (");
+            print_uart_addr(nr_blocks);
+            print_uart(" blocks) ");
+        }
+        uint64_t len = capacity;
+        res = sd_copy_lz4(dest, &len, first_lba, nr_blocks, dest + capacity, LZ4_STAGING_SIZE);
+        if (res == 0 && len != load_size)
+            res = SD_COPY_ERROR_LZ4;
+    }
+    else if (nr_blocks > size)
+    {
+        print_uart("boot image too large: ");
+        print_uart_addr(nr_blocks);
+        print_uart(" blocks\r\n");
+        return -3;
+    }
+    else
+    {
+        if (VERBOSITY >= VERBOSITY_INFO)
+        {
+            print_uart("copying boot image (");
+            print_uart_addr(nr_blocks);
+            print_uart(" blocks) ");
+        }
+        res = sd_copy(dest, first_lba, nr_blocks);
+    }
 
     if (res != 0)
     {
@@ -103,6 +357,13 @@ int gpt_find_boot_partition(uint8_t* dest, uint32_t size)
         return -2;
     }
 
-    print_uart(" done!\r\n");
+    if (load_size != 0 && crc32(0, dest, load_size) != image_crc)
+    {
+        print_uart("boot image checksum mismatch\r\n");
+        return -4;
+    }
+
+    if (VERBOSITY >= VERBOSITY_INFO)
+        print_uart(" done!\r\n");
     return 0;
 }
\ No newline at end of file
@@ -2,8 +2,24 @@
 
 #include <stdint.h>
 
-// LBA 0: Protective MBR
-// ignored here
+// LBA 0: Protective MBR, only used to locate the backup GPT
+#define MBR_PARTITION_OFFSET 446
+#define MBR_TYPE_PROTECTIVE 0xee
+
+typedef struct mbr_partition
+{
+    uint8_t status;
+    uint8_t first_chs[3];
+    uint8_t type;
+    uint8_t last_chs[3];
+    uint8_t first_lba[4]; //! little endian
+    uint8_t nr_lba[4];    //! little endian
+} mbr_partition_t;
+
+#define GPT_SIGNATURE 0x5452415020494645ULL // "EFI PART"
+#define GPT_HEADER_SIZE 92
+// 128 entries of 128 bytes
+#define GPT_MAX_ENTRY_BLOCKS 32
 
 // Partition Table Header (LBA 1)
 typedef struct gpt_pth
@@ -35,5 +51,34 @@ typedef struct partition_entries
     uint8_t name[72]; //! utf16 encoded
 } partition_entries_t;
 
-// Find boot partition and load it to the destination
+// The boot partition is the first one with this type GUID (ONIE boot,
+// sgdisk typecode 3000, 7412f7d5-a156-4b13-81dc-867174929325) and, if
+// BOOT_PARTITION_NAME is defined, the given name.
+#ifndef BOOT_PARTITION_TYPE
+#define BOOT_PARTITION_TYPE {0xd5, 0xf7, 0x12, 0x74, 0x56, 0xa1, 0x13, 0x4b, \
+                             0x81, 0xdc, 0x86, 0x71, 0x74, 0x92, 0x93, 0x25}
+#endif
+
+// Optional boot image header, stored in the first block of the boot
+// partition. The payload starts at the following block and is size bytes
+// long, crc is the CRC32 (as used by zlib) over the loaded image.
+#define BOOT_IMAGE_MAGIC 0x474d49544f4f4241ULL // "ABOOTIMG"
+
+// the payload is an LZ4 frame which decompresses to load_size bytes
+#define BOOT_IMAGE_LZ4 0x1
+
+typedef struct boot_image_header
+{
+    uint64_t magic;
+    uint64_t size;
+    uint32_t crc;
+    uint32_t flags;
+    uint64_t load_size;
+} boot_image_header_t;
+
+// CRC32 (polynomial 0x04c11db7, reflected)
+uint32_t crc32(uint32_t crc, const uint8_t *data, uint64_t len);
+
+// Find boot partition and load it to the destination, size is the maximum
+// number of blocks which fit into the destination
 int gpt_find_boot_partition(uint8_t* dest, uint32_t size);
\ No newline at end of file
@@ -0,0 +1,178 @@
+#include "lz4.h"
+
+// frame descriptor flags
+#define LZ4_FLG_VERSION_MASK 0xc0
+#define LZ4_FLG_VERSION 0x40
+#define LZ4_FLG_BLOCK_CHECKSUM 0x10
+#define LZ4_FLG_CONTENT_SIZE 0x08
+#define LZ4_FLG_CONTENT_CHECKSUM 0x04
+#define LZ4_FLG_DICT_ID 0x01
+
+#define LZ4_BLOCK_UNCOMPRESSED 0x80000000
+#define LZ4_MIN_MATCH 4
+
+static uint32_t read_le32(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+void lz4_stream_init(lz4_stream_t *s, void *dst, uint64_t size)
+{
+    s->start = dst;
+    s->out = dst;
+    s->end = s->start + size;
+    s->block_max = 0;
+    s->flags = 0;
+    s->state = LZ4_STATE_HEADER;
+}
+
+// decompress a single block, matches may reach back into previous blocks
+static int lz4_decode_block(lz4_stream_t *s, const uint8_t *ip, uint32_t len)
+{
+    const uint8_t *iend = ip + len;
+    uint8_t *op = s->out;
+
+    while (ip < iend)
+    {
+        uint8_t token = *ip++;
+        uint32_t n = token >> 4;
+
+        // literals
+        if (n == 15)
+        {
+            uint8_t b;
+            do
+            {
+                if (ip >= iend)
+                    return LZ4_ERROR_FORMAT;
+                b = *ip++;
+                n += b;
+            } while (b == 255);
+        }
+        if (n > (uint32_t)(iend - ip))
+            return LZ4_ERROR_FORMAT;
+        if (n > (uint64_t)(s->end - op))
+            return LZ4_ERROR_OVERFLOW;
+        for (; n > 0; n--)
+            *op++ = *ip++;
+
+        // the last sequence only consists of literals
+        if (ip >= iend)
+            break;
+
+        // match
+        if (iend - ip < 2)
+            return LZ4_ERROR_FORMAT;
+        uint32_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > (uint64_t)(op - s->start))
+            return LZ4_ERROR_FORMAT;
+
+        n = token & 0xf;
+        if (n == 15)
+        {
+            uint8_t b;
+            do
+            {
+                if (ip >= iend)
+                    return LZ4_ERROR_FORMAT;
+                b = *ip++;
+                n += b;
+            } while (b == 255);
+        }
+        n += LZ4_MIN_MATCH;
+        if (n > (uint64_t)(s->end - op))
+            return LZ4_ERROR_OVERFLOW;
+
+        // byte wise, source and destination may overlap
+        const uint8_t *match = op - offset;
+        for (; n > 0; n--)
+            *op++ = *match++;
+    }
+
+    s->out = op;
+    return 0;
+}
+
+long lz4_stream_decode(lz4_stream_t *s, const uint8_t *in, uint32_t len)
+{
+    uint32_t pos = 0;
+
+    while (s->state != LZ4_STATE_DONE)
+    {
+        const uint8_t *p = in + pos;
+        uint32_t avail = len - pos;
+
+        if (s->state == LZ4_STATE_HEADER)
+        {
+            // magic, FLG, BD and HC + optional content size and dictionary id
+            if (avail < 7)
+                break;
+            if (read_le32(p) != LZ4_MAGIC)
+                return LZ4_ERROR_FORMAT;
+
+            uint8_t flg = p[4];
+            uint32_t hlen = 7;
+            if ((flg & LZ4_FLG_VERSION_MASK) != LZ4_FLG_VERSION)
+                return LZ4_ERROR_FORMAT;
+            if (flg & LZ4_FLG_CONTENT_SIZE)
+                hlen += 8;
+            if (flg & LZ4_FLG_DICT_ID)
+                hlen += 4;
+            if (avail < hlen)
+                break;
+
+            // 64 KiB, 256 KiB, 1 MiB or 4 MiB
+            uint32_t bd = (p[5] >> 4) & 0x7;
+            if (bd < 4)
+                return LZ4_ERROR_FORMAT;
+            s->block_max = 1 << (2 * bd + 8);
+            s->flags = flg;
+            s->state = LZ4_STATE_BLOCK;
+            pos += hlen;
+        }
+        else
+        {
+            if (avail < 4)
+                break;
+
+            uint32_t size = read_le32(p);
+            uint32_t data = size & ~LZ4_BLOCK_UNCOMPRESSED;
+
+            // end mark, followed by the content checksum
+            if (size == 0)
+            {
+                uint32_t n = (s->flags & LZ4_FLG_CONTENT_CHECKSUM) ? 8 : 4;
+                if (avail < n)
+                    break;
+                s->state = LZ4_STATE_DONE;
+                pos += n;
+                break;
+            }
+
+            if (data > s->block_max)
+                return LZ4_ERROR_FORMAT;
+
+            uint32_t n = 4 + data + ((s->flags & LZ4_FLG_BLOCK_CHECKSUM) ? 4 : 0);
+            if (avail < n)
+                break;
+
+            if (size & LZ4_BLOCK_UNCOMPRESSED)
+            {
+                if (data > (uint64_t)(s->end - s->out))
+                    return LZ4_ERROR_OVERFLOW;
+                for (uint32_t i = 0; i < data; i++)
+                    *s->out++ = p[4 + i];
+            }
+            else
+            {
+                int rc = lz4_decode_block(s, p + 4, data);
+                if (rc != 0)
+                    return rc;
+            }
+            pos += n;
+        }
+    }
+
+    return pos;
+}
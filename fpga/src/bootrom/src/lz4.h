@@ -0,0 +1,37 @@
+#pragma once
+
+#include <stdint.h>
+
+// Streaming decoder for the LZ4 frame format
+// (https://github.com/lz4/lz4/blob/dev/doc/lz4_Frame_format.md).
+// Checksums are not verified, the boot image carries its own CRC32.
+
+#define LZ4_MAGIC 0x184d2204
+
+// buffer for the compressed data which is staged until a whole block can be
+// decoded, fits the 64 KiB block size (lz4 -B4) and the next SD blocks
+#define LZ4_STAGING_SIZE 0x20000
+
+#define LZ4_ERROR_FORMAT -1
+#define LZ4_ERROR_OVERFLOW -2
+
+#define LZ4_STATE_HEADER 0
+#define LZ4_STATE_BLOCK 1
+#define LZ4_STATE_DONE 2
+
+typedef struct lz4_stream
+{
+    uint8_t *start; // output buffer
+    uint8_t *out;   // next byte to be written
+    uint8_t *end;   // end of the output buffer
+    uint32_t block_max;
+    uint8_t flags;
+    int state;
+} lz4_stream_t;
+
+void lz4_stream_init(lz4_stream_t *s, void *dst, uint64_t size);
+
+// Decode all complete frame headers and blocks in [in, in + len), returns the
+// number of consumed bytes (the remainder has to be passed again together
+// with more data) or an error.
+long lz4_stream_decode(lz4_stream_t *s, const uint8_t *in, uint32_t len);
@@ -2,13 +2,29 @@
 #include "spi.h"
 #include "sd.h"
 #include "gpt.h"
+#include "netboot.h"
+#include "platform.h"
 
 int main()
 {
     init_uart();
-    print_uart("Hello World!\r\n");
+    if (VERBOSITY >= VERBOSITY_INFO)
+        print_uart("Hello World!\r\n");
 
-    int res = gpt_find_boot_partition((uint8_t *)0x80000000UL, 2 * 16384);
+    int res;
+
+    if (read_reg(GPIO2_DATA_REG) & NETBOOT_SWITCH)
+        res = netboot((uint8_t *)DRAM_BASE, DRAM_SIZE - STACK_SIZE);
+    else
+        res = gpt_find_boot_partition((uint8_t *)DRAM_BASE, (DRAM_SIZE - STACK_SIZE) / 512);
+
+    // the next stage re-initializes the UART
+    uart_flush();
+
+#ifdef BOOTROM_HOST
+    // the harness checks the loaded image
+    return res;
+#endif
 
     if (res == 0)
     {
@@ -0,0 +1,376 @@
+#include "netboot.h"
+
+#include "eth.h"
+#include "uart.h"
+
+#define ETH_HEADER 14
+#define IP_HEADER 20
+#define UDP_HEADER 8
+#define UDP_PAYLOAD (ETH_HEADER + IP_HEADER + UDP_HEADER)
+
+#define ETH_TYPE_IP 0x0800
+#define ETH_TYPE_ARP 0x0806
+#define IP_PROTOCOL_UDP 17
+
+#define ARP_REQUEST 1
+#define ARP_REPLY 2
+
+#define TFTP_RRQ 1
+#define TFTP_DATA 3
+#define TFTP_ACK 4
+#define TFTP_ERROR 5
+#define TFTP_OACK 6
+
+typedef struct netboot_state
+{
+    uint8_t mac[6];
+    uint8_t ip[4];
+    uint8_t server_mac[6];
+    uint8_t server_ip[4];
+    int server_mac_valid;
+    uint16_t server_port; // transfer id chosen by the server
+    uint8_t tx[ETH_FRAME_MAX];
+    uint8_t rx[ETH_FRAME_MAX];
+} netboot_state_t;
+
+static uint64_t get_cycle()
+{
+#ifdef BOOTROM_HOST
+    return host_cycle();
+#else
+    uint64_t cycle;
+    __asm__ volatile("rdcycle %0" : "=r"(cycle));
+    return cycle;
+#endif
+}
+
+static void put16(uint8_t *p, uint16_t v)
+{
+    p[0] = v >> 8;
+    p[1] = v;
+}
+
+static uint16_t get16(const uint8_t *p)
+{
+    return (p[0] << 8) | p[1];
+}
+
+static void copy(uint8_t *dst, const uint8_t *src, uint32_t len)
+{
+    for (uint32_t i = 0; i < len; i++)
+        dst[i] = src[i];
+}
+
+static int equal(const uint8_t *a, const uint8_t *b, uint32_t len)
+{
+    for (uint32_t i = 0; i < len; i++)
+    {
+        if (a[i] != b[i])
+            return 0;
+    }
+    return 1;
+}
+
+static uint16_t ip_checksum(const uint8_t *p, uint32_t len)
+{
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < len; i += 2)
+        sum += get16(p + i);
+    while (sum >> 16)
+        sum = (sum & 0xffff) + (sum >> 16);
+    return ~sum;
+}
+
+static void eth_header(netboot_state_t *s, const uint8_t *dst, uint16_t type)
+{
+    copy(s->tx, dst, 6);
+    copy(s->tx + 6, s->mac, 6);
+    put16(s->tx + 12, type);
+}
+
+static void arp_send(netboot_state_t *s, uint16_t op, const uint8_t *mac, const uint8_t *ip)
+{
+    static const uint8_t broadcast[6] = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+    uint8_t *arp = s->tx + ETH_HEADER;
+
+    eth_header(s, op == ARP_REQUEST ? broadcast : mac, ETH_TYPE_ARP);
+    put16(arp, 1);           // ethernet
+    put16(arp + 2, ETH_TYPE_IP);
+    arp[4] = 6;
+    arp[5] = 4;
+    put16(arp + 6, op);
+    copy(arp + 8, s->mac, 6);
+    copy(arp + 14, s->ip, 4);
+    copy(arp + 18, op == ARP_REQUEST ? broadcast : mac, 6);
+    copy(arp + 24, ip, 4);
+    eth_send(s->tx, ETH_HEADER + 28);
+}
+
+// send the UDP payload which has been placed at s->tx + UDP_PAYLOAD
+static void udp_send(netboot_state_t *s, uint16_t port, uint32_t len)
+{
+    uint8_t *ip = s->tx + ETH_HEADER;
+    uint8_t *udp = ip + IP_HEADER;
+
+    eth_header(s, s->server_mac, ETH_TYPE_IP);
+    ip[0] = 0x45; // IPv4, 20 byte header
+    ip[1] = 0;
+    put16(ip + 2, IP_HEADER + UDP_HEADER + len);
+    put16(ip + 4, 0);      // identification
+    put16(ip + 6, 0x4000); // don't fragment
+    ip[8] = 64;            // ttl
+    ip[9] = IP_PROTOCOL_UDP;
+    put16(ip + 10, 0);
+    copy(ip + 12, s->ip, 4);
+    copy(ip + 16, s->server_ip, 4);
+    put16(ip + 10, ip_checksum(ip, IP_HEADER));
+
+    put16(udp, NETBOOT_LOCAL_PORT);
+    put16(udp + 2, port);
+    put16(udp + 4, UDP_HEADER + len);
+    put16(udp + 6, 0); // no checksum
+
+    eth_send(s->tx, UDP_PAYLOAD + len);
+}
+
+// Receive the next frame, answers ARP requests and learns the server's MAC.
+// Returns the length of a UDP payload for our port (at s->rx + UDP_PAYLOAD)
+// and its source port, 0 if there is nothing (else) to do.
+static uint32_t netboot_poll(netboot_state_t *s, uint16_t *port)
+{
+    uint32_t len = eth_recv(s->rx);
+
+    if (len < ETH_HEADER)
+        return 0;
+
+    uint16_t type = get16(s->rx + 12);
+
+    if (type == ETH_TYPE_ARP && len >= ETH_HEADER + 28)
+    {
+        uint8_t *arp = s->rx + ETH_HEADER;
+        if (!equal(arp + 24, s->ip, 4))
+            return 0;
+        if (get16(arp + 6) == ARP_REQUEST)
+        {
+            arp_send(s, ARP_REPLY, arp + 8, arp + 14);
+        }
+        else if (get16(arp + 6) == ARP_REPLY && equal(arp + 14, s->server_ip, 4))
+        {
+            copy(s->server_mac, arp + 8, 6);
+            s->server_mac_valid = 1;
+        }
+        return 0;
+    }
+
+    if (type != ETH_TYPE_IP || len < UDP_PAYLOAD)
+        return 0;
+
+    uint8_t *ip = s->rx + ETH_HEADER;
+    uint8_t *udp = ip + IP_HEADER;
+
+    // no IP options, no fragments
+    if (ip[0] != 0x45 || ip[9] != IP_PROTOCOL_UDP || (get16(ip + 6) & 0x3fff) != 0 ||
+        !equal(ip + 16, s->ip, 4) || !equal(ip + 12, s->server_ip, 4) ||
+        get16(udp + 2) != NETBOOT_LOCAL_PORT)
+        return 0;
+
+    uint32_t udp_len = get16(udp + 4);
+    if (udp_len < UDP_HEADER || ETH_HEADER + IP_HEADER + udp_len > len)
+        return 0;
+
+    *port = get16(udp);
+    return udp_len - UDP_HEADER;
+}
+
+static int arp_resolve(netboot_state_t *s)
+{
+    uint16_t port;
+
+    for (int retry = 0; retry < NETBOOT_RETRIES; retry++)
+    {
+        arp_send(s, ARP_REQUEST, 0, s->server_ip);
+
+        uint64_t start = get_cycle();
+        while (get_cycle() - start < NETBOOT_TIMEOUT)
+        {
+            netboot_poll(s, &port);
+            if (s->server_mac_valid)
+                return 0;
+        }
+    }
+    return NETBOOT_ERROR_ARP;
+}
+
+static uint32_t tftp_rrq(netboot_state_t *s)
+{
+    // file name, transfer mode and the block size option
+    static const char request[] = NETBOOT_FILE "\0octet\0blksize\0" "1468";
+    uint8_t *p = s->tx + UDP_PAYLOAD;
+
+    put16(p, TFTP_RRQ);
+    copy(p + 2, (const uint8_t *)request, sizeof(request));
+    return 2 + sizeof(request);
+}
+
+// the server may only grant a smaller block size than we asked for
+static uint32_t tftp_oack_blksize(const uint8_t *p, uint32_t len)
+{
+    static const char option[] = "blksize";
+    uint32_t i = 2;
+
+    while (i < len)
+    {
+        const uint8_t *name = p + i;
+        while (i < len && p[i])
+            i++;
+        const uint8_t *value = p + ++i;
+        while (i < len && p[i])
+            i++;
+        i++;
+        if (i > len)
+            break;
+
+        if (equal(name, (const uint8_t *)option, sizeof(option)))
+        {
+            uint32_t blksize = 0;
+            for (; *value >= '0' && *value <= '9'; value++)
+                blksize = blksize * 10 + (*value - '0');
+            if (blksize > 0 && blksize <= NETBOOT_BLKSIZE)
+                return blksize;
+        }
+    }
+    return 512;
+}
+
+static uint32_t tftp_ack(netboot_state_t *s, uint16_t block)
+{
+    uint8_t *p = s->tx + UDP_PAYLOAD;
+
+    put16(p, TFTP_ACK);
+    put16(p + 2, block);
+    return 4;
+}
+
+int netboot(uint8_t *dest, uint64_t size)
+{
+    static const uint8_t mac[6] = NETBOOT_MAC;
+    static const uint8_t ip[4] = NETBOOT_IP;
+    static const uint8_t server_ip[4] = NETBOOT_SERVER_IP;
+    netboot_state_t s;
+    uint64_t offset = 0;
+    uint32_t blksize = 512;
+    uint16_t block = 1;
+    uint16_t port = NETBOOT_TFTP_PORT;
+    uint32_t len;
+    int retry = 0;
+
+    if (VERBOSITY >= VERBOSITY_INFO)
+        print_uart("netboot: " NETBOOT_FILE "\r\n");
+
+    copy(s.mac, mac, 6);
+    copy(s.ip, ip, 4);
+    copy(s.server_ip, server_ip, 4);
+    s.server_mac_valid = 0;
+
+    eth_init(s.mac);
+
+    if (arp_resolve(&s) != 0)
+    {
+        print_uart("tftp server does not answer arp requests\r\n");
+        return NETBOOT_ERROR_ARP;
+    }
+
+    // the read request is retransmitted until the server answers from its
+    // transfer port, afterwards the last ACK is
+    len = tftp_rrq(&s);
+    udp_send(&s, port, len);
+
+    uint64_t start = get_cycle();
+    while (1)
+    {
+        uint16_t src;
+        uint32_t n = netboot_poll(&s, &src);
+
+        if (n == 0)
+        {
+            if (get_cycle() - start < NETBOOT_TIMEOUT)
+                continue;
+            if (++retry > NETBOOT_RETRIES)
+            {
+                print_uart("tftp timeout\r\n");
+                return NETBOOT_ERROR_TIMEOUT;
+            }
+            udp_send(&s, port, len);
+            start = get_cycle();
+            continue;
+        }
+
+        // the first answer fixes the server's transfer id
+        if (port == NETBOOT_TFTP_PORT)
+            port = src;
+        if (src != port || n < 4)
+            continue;
+
+        uint8_t *p = s.rx + UDP_PAYLOAD;
+        uint16_t op = get16(p);
+
+        if (op == TFTP_ERROR)
+        {
+            print_uart("tftp error: ");
+            p[n - 1] = 0;
+            print_uart((const char *)p + 4);
+            print_uart("\r\n");
+            return NETBOOT_ERROR_SERVER;
+        }
+
+        if (op == TFTP_OACK && block == 1)
+        {
+            blksize = tftp_oack_blksize(p, n);
+            len = tftp_ack(&s, 0);
+        }
+        else if (op == TFTP_DATA && get16(p + 2) == block)
+        {
+            n -= 4;
+            if (n > blksize || offset + n > size)
+            {
+                print_uart("tftp: boot image too large\r\n");
+                return NETBOOT_ERROR_SIZE;
+            }
+            copy(dest + offset, p + 4, n);
+            offset += n;
+
+            len = tftp_ack(&s, block++);
+            udp_send(&s, port, len);
+
+            if (VERBOSITY >= VERBOSITY_INFO && (block % 1000) == 0)
+                print_uart(".");
+
+            // a short block ends the transfer
+            if (n < blksize)
+                break;
+            retry = 0;
+            start = get_cycle();
+            continue;
+        }
+        else if (op == TFTP_DATA && get16(p + 2) == (uint16_t)(block - 1))
+        {
+            // our ACK got lost, resend it
+        }
+        else
+        {
+            continue;
+        }
+
+        udp_send(&s, port, len);
+        retry = 0;
+        start = get_cycle();
+    }
+
+    if (VERBOSITY >= VERBOSITY_INFO)
+    {
+        print_uart(" done (");
+        print_uart_addr(offset);
+        print_uart(" bytes)\r\n");
+    }
+    return 0;
+}
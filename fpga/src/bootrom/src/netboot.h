@@ -0,0 +1,38 @@
+#pragma once
+
+#include <stdint.h>
+
+// Static configuration of the TFTP boot (there is no DHCP client)
+#ifndef NETBOOT_MAC
+#define NETBOOT_MAC {0x02, 0x00, 0x00, 0x00, 0x00, 0x01} // locally administered
+#endif
+#ifndef NETBOOT_IP
+#define NETBOOT_IP {192, 168, 0, 2}
+#endif
+#ifndef NETBOOT_SERVER_IP
+#define NETBOOT_SERVER_IP {192, 168, 0, 1}
+#endif
+#ifndef NETBOOT_FILE
+#define NETBOOT_FILE "bbl.bin"
+#endif
+
+// boot from the network instead of the SD card if this DIP switch is set
+#define NETBOOT_SWITCH 0x80
+
+#define NETBOOT_TFTP_PORT 69
+#define NETBOOT_LOCAL_PORT 0xc000
+// largest block which fits into an Ethernet frame (RFC 2348), keep in sync
+// with the option in the read request
+#define NETBOOT_BLKSIZE 1468
+// retransmission timeout (1 s at 50 MHz) and maximum number of retries
+#define NETBOOT_TIMEOUT 50000000
+#define NETBOOT_RETRIES 10
+
+// errors
+#define NETBOOT_ERROR_ARP -1
+#define NETBOOT_ERROR_TIMEOUT -2
+#define NETBOOT_ERROR_SERVER -3
+#define NETBOOT_ERROR_SIZE -4
+
+// Fetch NETBOOT_FILE from the TFTP server into dest (size bytes at most)
+int netboot(uint8_t *dest, uint64_t size);
@@ -1,6 +1,7 @@
 #include "sd.h"
 #include "spi.h"
 #include "uart.h"
+#include "lz4.h"
 
 // spi full duplex: send 0xff to receive byte
 uint8_t sd_dummy()
@@ -39,6 +40,9 @@ uint8_t sd_cmd(uint8_t cmd, uint32_t arg, uint8_t crc)
 
 void print_status(const char *cmd, uint8_t response)
 {
+    if (VERBOSITY < VERBOSITY_DEBUG)
+        return;
+
     print_uart("SD command ");
     print_uart(cmd);
     print_uart(" \tresponse : ");
@@ -100,7 +104,8 @@ int init_sd()
 {
     spi_init();
 
-    print_uart("initializing SD... \r\n");
+    if (VERBOSITY >= VERBOSITY_INFO)
+        print_uart("initializing SD... \r\n");
     // mostly taken from
     // https://electronics.stackexchange.com/questions/77417/what-is-the-correct-command-sequence-for-microsd-card-initialization-in-spi
     // and the siFive implementation:
@@ -116,6 +121,9 @@ int init_sd()
         return SD_INIT_ERROR_CMD8;
     if (!sd_acmd41())
         return SD_INIT_ERROR_ACMD41;
+
+    // the card is out of identification mode, switch to the transfer clock
+    spi_set_clock(SPI_CLOCK_FAST);
     return 0;
 }
 
@@ -128,28 +136,80 @@ uint8_t crc7(uint8_t prev, uint8_t in)
     return remainder & 0x7f;
 }
 
-uint16_t crc16(uint16_t crc, uint8_t data)
+// CRC16-CCITT (polynomial 0x11021) lookup table, one entry per input byte
+static const uint16_t crc16_table[256] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50a5, 0x60c6, 0x70e7,
+    0x8108, 0x9129, 0xa14a, 0xb16b, 0xc18c, 0xd1ad, 0xe1ce, 0xf1ef,
+    0x1231, 0x0210, 0x3273, 0x2252, 0x52b5, 0x4294, 0x72f7, 0x62d6,
+    0x9339, 0x8318, 0xb37b, 0xa35a, 0xd3bd, 0xc39c, 0xf3ff, 0xe3de,
+    0x2462, 0x3443, 0x0420, 0x1401, 0x64e6, 0x74c7, 0x44a4, 0x5485,
+    0xa56a, 0xb54b, 0x8528, 0x9509, 0xe5ee, 0xf5cf, 0xc5ac, 0xd58d,
+    0x3653, 0x2672, 0x1611, 0x0630, 0x76d7, 0x66f6, 0x5695, 0x46b4,
+    0xb75b, 0xa77a, 0x9719, 0x8738, 0xf7df, 0xe7fe, 0xd79d, 0xc7bc,
+    0x48c4, 0x58e5, 0x6886, 0x78a7, 0x0840, 0x1861, 0x2802, 0x3823,
+    0xc9cc, 0xd9ed, 0xe98e, 0xf9af, 0x8948, 0x9969, 0xa90a, 0xb92b,
+    0x5af5, 0x4ad4, 0x7ab7, 0x6a96, 0x1a71, 0x0a50, 0x3a33, 0x2a12,
+    0xdbfd, 0xcbdc, 0xfbbf, 0xeb9e, 0x9b79, 0x8b58, 0xbb3b, 0xab1a,
+    0x6ca6, 0x7c87, 0x4ce4, 0x5cc5, 0x2c22, 0x3c03, 0x0c60, 0x1c41,
+    0xedae, 0xfd8f, 0xcdec, 0xddcd, 0xad2a, 0xbd0b, 0x8d68, 0x9d49,
+    0x7e97, 0x6eb6, 0x5ed5, 0x4ef4, 0x3e13, 0x2e32, 0x1e51, 0x0e70,
+    0xff9f, 0xefbe, 0xdfdd, 0xcffc, 0xbf1b, 0xaf3a, 0x9f59, 0x8f78,
+    0x9188, 0x81a9, 0xb1ca, 0xa1eb, 0xd10c, 0xc12d, 0xf14e, 0xe16f,
+    0x1080, 0x00a1, 0x30c2, 0x20e3, 0x5004, 0x4025, 0x7046, 0x6067,
+    0x83b9, 0x9398, 0xa3fb, 0xb3da, 0xc33d, 0xd31c, 0xe37f, 0xf35e,
+    0x02b1, 0x1290, 0x22f3, 0x32d2, 0x4235, 0x5214, 0x6277, 0x7256,
+    0xb5ea, 0xa5cb, 0x95a8, 0x8589, 0xf56e, 0xe54f, 0xd52c, 0xc50d,
+    0x34e2, 0x24c3, 0x14a0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+    0xa7db, 0xb7fa, 0x8799, 0x97b8, 0xe75f, 0xf77e, 0xc71d, 0xd73c,
+    0x26d3, 0x36f2, 0x0691, 0x16b0, 0x6657, 0x7676, 0x4615, 0x5634,
+    0xd94c, 0xc96d, 0xf90e, 0xe92f, 0x99c8, 0x89e9, 0xb98a, 0xa9ab,
+    0x5844, 0x4865, 0x7806, 0x6827, 0x18c0, 0x08e1, 0x3882, 0x28a3,
+    0xcb7d, 0xdb5c, 0xeb3f, 0xfb1e, 0x8bf9, 0x9bd8, 0xabbb, 0xbb9a,
+    0x4a75, 0x5a54, 0x6a37, 0x7a16, 0x0af1, 0x1ad0, 0x2ab3, 0x3a92,
+    0xfd2e, 0xed0f, 0xdd6c, 0xcd4d, 0xbdaa, 0xad8b, 0x9de8, 0x8dc9,
+    0x7c26, 0x6c07, 0x5c64, 0x4c45, 0x3ca2, 0x2c83, 0x1ce0, 0x0cc1,
+    0xef1f, 0xff3e, 0xcf5d, 0xdf7c, 0xaf9b, 0xbfba, 0x8fd9, 0x9ff8,
+    0x6e17, 0x7e36, 0x4e55, 0x5e74, 0x2e93, 0x3eb2, 0x0ed1, 0x1ef0,
+};
+
+uint16_t crc16(uint16_t crc, const uint8_t *data, uint32_t len)
 {
-    // CRC polynomial 0x11021
-    crc = (uint8_t)(crc >> 8) | (crc << 8);
-    crc ^= data;
-    crc ^= (uint8_t)(crc >> 4) & 0xf;
-    crc ^= crc << 12;
-    crc ^= (crc & 0xff) << 5;
+    // process the block a 64-bit word at a time, the SPI FIFO stores the
+    // bytes in order so the first byte lives in the lowest byte of the word
+    for (; len >= 8 && ((uintptr_t)data & 0x7) == 0; len -= 8, data += 8)
+    {
+        uint64_t word = *(const uint64_t *)data;
+        for (int j = 0; j < 8; j++, word >>= 8)
+        {
+            crc = (crc << 8) ^ crc16_table[((crc >> 8) ^ word) & 0xff];
+        }
+    }
+
+    for (; len > 0; len--, data++)
+    {
+        crc = (crc << 8) ^ crc16_table[((crc >> 8) ^ *data) & 0xff];
+    }
     return crc;
 }
 
-int sd_copy(void *dst, uint32_t src_lba, uint32_t size)
+#if SD_CRC_MODE == SD_CRC_DEFERRED
+// verify a batch of received blocks against the CRCs sent by the card
+static int sd_check_crcs(const uint8_t *p, const uint16_t *crc_exp, int n)
 {
-    volatile uint8_t *p = dst;
-    long i = size;
-    int rc = 0;
-
-    uint8_t ff[128];
-    for (int j = 0; j < 128; j++)
-        ff[j] = 0xff;
+    for (int j = 0; j < n; j++, p += SD_BLOCK_SIZE)
+    {
+        if (crc16(0, p, SD_BLOCK_SIZE) != crc_exp[j])
+            return SD_COPY_ERROR_CMD18_CRC;
+    }
+    return 0;
+}
+#endif
 
+int sd_read_start(sd_reader_t *r, uint32_t src_lba)
+{
     uint8_t crc = 0;
+
+    r->queued = 0;
     crc = crc7(crc, 0x40 | SD_CMD_READ_BLOCK_MULTIPLE);
     crc = crc7(crc, (src_lba >> 24) & 0xff);
     crc = crc7(crc, (src_lba >> 16) & 0xff);
@@ -162,47 +222,182 @@ int sd_copy(void *dst, uint32_t src_lba, uint32_t size)
             sd_dummy();
 
         print_uart("could not read SD block\r\n");
-        return -1;
+        return SD_COPY_ERROR_CMD18;
     }
+    return 0;
+}
+
+// Receive the next data block, returns the CRC sent by the card. If another
+// block follows its transfer gets started right away (up to a FIFO full)
+// so that the card keeps sending while the CPU verifies this block.
+static uint16_t sd_receive_block(sd_reader_t *r, uint8_t *p, int more)
+{
+    uint8_t token, crc_buf[2];
+
+    do
+    {
+        spi_read_queued(&token, 1, &r->queued);
+    } while (token != SD_DATA_TOKEN);
+
+    // stream the whole block through the spi fifos
+    spi_read_queued(p, SD_BLOCK_SIZE, &r->queued);
+    spi_read_queued(crc_buf, 2, &r->queued);
+
+    if (more)
+        spi_queue_dummy(&r->queued, SPI_FIFO_DEPTH);
+
+    return ((uint16_t)crc_buf[0] << 8) | crc_buf[1];
+}
+
+int sd_read_block(sd_reader_t *r, uint8_t *p, int more)
+{
+    uint16_t crc_exp = sd_receive_block(r, p, more);
+
+#if SD_CRC_MODE != SD_CRC_NONE
+    if (crc16(0, p, SD_BLOCK_SIZE) != crc_exp)
+        return SD_COPY_ERROR_CMD18_CRC;
+#else
+    (void)crc_exp;
+#endif
+    return 0;
+}
+
+void sd_read_stop(sd_reader_t *r)
+{
+    // drop whatever has been fetched ahead
+    spi_read_queued(0, r->queued, &r->queued);
+
+    sd_cmd(SD_CMD_STOP_TRANSMISSION, 0, 0x01);
+    sd_dummy();
+}
+
+static int sd_copy_blocks(void *dst, uint32_t src_lba, uint32_t size)
+{
+    sd_reader_t r;
+    uint8_t *p = dst;
+    long i = size;
+    int rc = sd_read_start(&r, src_lba);
+
+    if (rc != 0)
+        return rc;
+#if SD_CRC_MODE == SD_CRC_DEFERRED
+    uint8_t *batch = p;
+    uint16_t batch_crc[SD_CRC_BATCH];
+    int n = 0;
+#endif
     do
     {
-        uint16_t crc, crc_exp;
-        long n;
-
-        crc = 0;
-        n = 512;
-        while (sd_dummy() != SD_DATA_TOKEN)
-            ;
-        do
+#if SD_CRC_MODE == SD_CRC_DEFERRED
+        batch_crc[n++] = sd_receive_block(&r, p, i > 1);
+        if (n == SD_CRC_BATCH || i == 1)
+        {
+            rc = sd_check_crcs(batch, batch_crc, n);
+            if (rc != 0)
+                break;
+            batch = p + SD_BLOCK_SIZE;
+            n = 0;
+        }
+#else
+        rc = sd_read_block(&r, p, i > 1);
+        if (rc != 0)
+            break;
+#endif
+        p += SD_BLOCK_SIZE;
+
+        if (VERBOSITY >= VERBOSITY_INFO && (i % 1000) == 0)
         {
-            int bytes_per_transfer = 64;
-            spi_write_bytes(ff, bytes_per_transfer, (uint8_t *)p);
-            for (int i = 0; i < bytes_per_transfer; i++)
+            print_uart(".");
+        }
+    } while (--i > 0);
+
+    sd_read_stop(&r);
+    return rc;
+}
+
+int sd_copy(void *dst, uint32_t src_lba, uint32_t size)
+{
+    int rc = sd_copy_blocks(dst, src_lba, size);
+
+    if (rc == SD_COPY_ERROR_CMD18_CRC)
+    {
+        // the card (or the wiring) can't keep up, retry at the slow clock
+        print_uart("crc error, retrying at lower spi clock\r\n");
+        spi_set_clock(SPI_CLOCK_SLOW);
+        rc = sd_copy_blocks(dst, src_lba, size);
+    }
+    return rc;
+}
+
+static int sd_copy_lz4_blocks(void *dst, uint64_t *len, uint32_t src_lba, uint32_t size,
+                              uint8_t *staging, uint32_t staging_size)
+{
+    lz4_stream_t s;
+    sd_reader_t r;
+    uint32_t rd = 0, wr = 0;
+    int rc = sd_read_start(&r, src_lba);
+
+    if (rc != 0)
+        return rc;
+
+    lz4_stream_init(&s, dst, *len);
+
+    for (uint32_t i = 0; i < size && s.state != LZ4_STATE_DONE; i++)
+    {
+        // move the undecoded rest to the front to make room for the next block
+        if (staging_size - wr < SD_BLOCK_SIZE)
+        {
+            if (rd == 0)
             {
-                crc = crc16(crc, p[i]);
+                rc = SD_COPY_ERROR_LZ4;
+                break;
             }
-            p += bytes_per_transfer;
-            n -= bytes_per_transfer;
-            // uint8_t x = sd_dummy();
-            // *p++ = x;
-            // crc = crc16(crc, x);
-        } while (n > 0);
+            for (uint32_t j = rd; j < wr; j++)
+                staging[j - rd] = staging[j];
+            wr -= rd;
+            rd = 0;
+        }
 
-        crc_exp = ((uint16_t)sd_dummy() << 8);
-        crc_exp |= sd_dummy();
+        rc = sd_read_block(&r, staging + wr, i + 1 < size);
+        if (rc != 0)
+            break;
+        wr += SD_BLOCK_SIZE;
 
-        if (crc != crc_exp)
+        // decode while the next block is fetched ahead
+        long n = lz4_stream_decode(&s, staging + rd, wr - rd);
+        if (n < 0)
         {
-            rc = SD_COPY_ERROR_CMD18_CRC;
+            rc = SD_COPY_ERROR_LZ4;
             break;
         }
-        if ((i % 1000) == 0)
+        rd += n;
+
+        if (VERBOSITY >= VERBOSITY_INFO && (i % 1000) == 0)
         {
             print_uart(".");
         }
-    } while (--i > 0);
+    }
 
-    sd_cmd(SD_CMD_STOP_TRANSMISSION, 0, 0x01);
-    sd_dummy();
+    sd_read_stop(&r);
+
+    if (rc == 0 && s.state != LZ4_STATE_DONE)
+        rc = SD_COPY_ERROR_LZ4;
+
+    *len = s.out - s.start;
+    return rc;
+}
+
+int sd_copy_lz4(void *dst, uint64_t *len, uint32_t src_lba, uint32_t size,
+                uint8_t *staging, uint32_t staging_size)
+{
+    uint64_t max = *len;
+    int rc = sd_copy_lz4_blocks(dst, len, src_lba, size, staging, staging_size);
+
+    if (rc == SD_COPY_ERROR_CMD18_CRC)
+    {
+        print_uart("crc error, retrying at lower spi clock\r\n");
+        spi_set_clock(SPI_CLOCK_SLOW);
+        *len = max;
+        rc = sd_copy_lz4_blocks(dst, len, src_lba, size, staging, staging_size);
+    }
     return rc;
 }
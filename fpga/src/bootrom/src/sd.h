@@ -5,8 +5,24 @@
 #define SD_CMD_STOP_TRANSMISSION 12
 #define SD_CMD_READ_BLOCK_MULTIPLE 18
 #define SD_DATA_TOKEN 0xfe
+#define SD_BLOCK_SIZE 512
 #define SD_COPY_ERROR_CMD18 -1
 #define SD_COPY_ERROR_CMD18_CRC -2
+#define SD_COPY_ERROR_LZ4 -3
+
+// CRC verification of the received data blocks:
+// - SD_CRC_INLINE: check every block right after it has been received
+// - SD_CRC_DEFERRED: check SD_CRC_BATCH blocks at once in a second pass
+// - SD_CRC_NONE: don't check the data blocks at all
+#define SD_CRC_INLINE 0
+#define SD_CRC_DEFERRED 1
+#define SD_CRC_NONE 2
+#ifndef SD_CRC_MODE
+#define SD_CRC_MODE SD_CRC_INLINE
+#endif
+#ifndef SD_CRC_BATCH
+#define SD_CRC_BATCH 64
+#endif
 
 // errors
 #define SD_INIT_ERROR_CMD0 -1
@@ -17,4 +33,21 @@ int init_sd();
 
 void put_sdcard_spi_mode();
 
-int sd_copy(void *dst, uint32_t src_lba, uint32_t size);
\ No newline at end of file
+// Multiple block read: start, read the blocks one by one, stop. more tells
+// sd_read_block that another block follows which is then fetched ahead.
+typedef struct sd_reader
+{
+    uint32_t queued; // bytes which have been fetched ahead
+} sd_reader_t;
+
+int sd_read_start(sd_reader_t *r, uint32_t src_lba);
+int sd_read_block(sd_reader_t *r, uint8_t *p, int more);
+void sd_read_stop(sd_reader_t *r);
+
+int sd_copy(void *dst, uint32_t src_lba, uint32_t size);
+
+// Copy size blocks of an LZ4 frame and decompress them into dst while they
+// are received, len holds the size of dst and returns the decompressed size.
+// The compressed data is staged in staging.
+int sd_copy_lz4(void *dst, uint64_t *len, uint32_t src_lba, uint32_t size,
+                uint8_t *staging, uint32_t staging_size);
\ No newline at end of file
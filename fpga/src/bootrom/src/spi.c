@@ -4,18 +4,31 @@
 
 void write_reg(uintptr_t addr, uint32_t value)
 {
+#ifdef BOOTROM_HOST
+    host_mmio_write(addr, value, 4);
+#else
     volatile uint32_t *loc_addr = (volatile uint32_t *)addr;
     *loc_addr = value;
+#endif
 }
 
 uint32_t read_reg(uintptr_t addr)
 {
+#ifdef BOOTROM_HOST
+    return host_mmio_read(addr, 4);
+#else
     return *(volatile uint32_t *)addr;
+#endif
 }
 
 void spi_init()
 {
-    print_uart("init SPI\r\n");
+    if (VERBOSITY >= VERBOSITY_DEBUG)
+        print_uart("init SPI\r\n");
+
+    // SD cards start in identification mode, the LEDs are off
+    *(uint32_t *)GPIO_SHADOW_BASE = 0;
+    spi_set_clock(SPI_CLOCK_SLOW);
 
     // reset the axi quadspi core
     write_reg(SPI_RESET_REG, 0x0a);
@@ -29,21 +42,44 @@ void spi_init()
     write_reg(SPI_CONTROL_REG, 0x104);
 
     uint32_t status = read_reg(SPI_STATUS_REG);
-    print_uart("status: 0x");
-    print_uart_addr(status);
-    print_uart("\r\n");
+    if (VERBOSITY >= VERBOSITY_DEBUG)
+    {
+        print_uart("status: 0x");
+        print_uart_addr(status);
+        print_uart("\r\n");
+    }
 
     // clear all fifos
     write_reg(SPI_CONTROL_REG, 0x166);
 
     status = read_reg(SPI_STATUS_REG);
-    print_uart("status: 0x");
-    print_uart_addr(status);
-    print_uart("\r\n");
+    if (VERBOSITY >= VERBOSITY_DEBUG)
+    {
+        print_uart("status: 0x");
+        print_uart_addr(status);
+        print_uart("\r\n");
+    }
 
     write_reg(SPI_CONTROL_REG, 0x06);
 
-    print_uart("SPI initialized!\r\n");
+    if (VERBOSITY >= VERBOSITY_DEBUG)
+        print_uart("SPI initialized!\r\n");
+}
+
+void spi_set_clock(int speed)
+{
+    // the output channel reads back the (unconnected) inputs, modify the
+    // shadow copy so that the LED bits are kept
+    uint32_t *shadow = (uint32_t *)GPIO_SHADOW_BASE;
+    uint32_t gpio = *shadow;
+
+    if (speed == SPI_CLOCK_FAST)
+        gpio |= SPI_CLK_SEL_BIT;
+    else
+        gpio &= ~SPI_CLK_SEL_BIT;
+
+    *shadow = gpio;
+    write_reg(GPIO_DATA_REG, gpio);
 }
 
 uint8_t spi_txrx(uint8_t byte)
@@ -67,7 +103,7 @@ uint8_t spi_txrx(uint8_t byte)
 
     uint32_t result = read_reg(SPI_RECEIVE_REG);
 
-    if ((read_reg(SPI_STATUS_REG) & 0x1) != 0x1)
+    if (VERBOSITY >= VERBOSITY_DEBUG && (read_reg(SPI_STATUS_REG) & 0x1) != 0x1)
     {
         print_uart("rx fifo not empty?? ");
         print_uart_addr(read_reg(SPI_STATUS_REG));
@@ -83,49 +119,86 @@ uint8_t spi_txrx(uint8_t byte)
     return result;
 }
 
-int spi_write_bytes(uint8_t *bytes, uint32_t len, uint8_t *ret)
+// Full duplex transfer which keeps the TX FIFO filled: the RX FIFO gets
+// drained while the transfer is running and refilled right after, at most
+// SPI_FIFO_DEPTH bytes are in flight so the RX FIFO can never overflow.
+// The responses to *queued dummy bytes which have been sent in advance
+// (see spi_queue_dummy) are received first.
+static void spi_stream(const uint8_t *bytes, uint32_t len, uint8_t *ret, uint32_t *queued)
 {
-    uint32_t status;
+    uint32_t tx = *queued < len ? *queued : len;
+    uint32_t rx = 0;
 
-    if (len > 256) // FIFO maxdepth 256
-        return -1;
+    *queued -= tx;
 
     // enable slave select
     write_reg(SPI_SLAVE_SELECT_REG, 0xfffffffe);
 
-    for (int i = 0; i < len; i++)
+    while (rx < len)
     {
-        write_reg(SPI_TRANSMIT_REG, bytes[i] & 0xff);
-    }
-
-    for (int i = 0; i < 50; i++)
-    {
-        __asm__ volatile(
-            "nop");
-    }
-
-    // enable spi control master flag
-    write_reg(SPI_CONTROL_REG, 0x106);
-
-    do
-    {
-        status = read_reg(SPI_STATUS_REG);
-    } while ((status & 0x1) == 0x1);
+        // refill the transmit fifo
+        for (; tx < len && tx - rx < SPI_FIFO_DEPTH; tx++)
+        {
+            write_reg(SPI_TRANSMIT_REG, bytes ? bytes[tx] : 0xff);
+        }
 
-    for (int i = 0; i < len;)
-    {
-        status = read_reg(SPI_STATUS_REG);
-        if ((status & 0x1) != 0x1) // recieve fifo not empty
+        // drain everything which has been received so far, the responses to
+        // queued bytes beyond len stay in the fifo for the next call
+        if ((read_reg(SPI_STATUS_REG) & SPI_STATUS_RX_EMPTY) == 0)
         {
-            ret[i++] = read_reg(SPI_RECEIVE_REG);
+            // occupancy is the number of entries - 1
+            uint32_t n = read_reg(SPI_RECEIVE_OCCUPANCY) + 1;
+            if (n > len - rx)
+                n = len - rx;
+            for (; n > 0; n--, rx++)
+            {
+                uint8_t byte = read_reg(SPI_RECEIVE_REG);
+                if (ret)
+                    ret[rx] = byte;
+            }
         }
     }
 
-    // disable slave select
-    write_reg(SPI_SLAVE_SELECT_REG, 0xffffffff);
+    // disable slave select, unless there are still bytes in flight
+    if (*queued == 0)
+        write_reg(SPI_SLAVE_SELECT_REG, 0xffffffff);
+}
 
-    // disable spi control master flag
-    write_reg(SPI_CONTROL_REG, 0x06);
+int spi_write_bytes(uint8_t *bytes, uint32_t len, uint8_t *ret)
+{
+    uint32_t queued = 0;
+
+    if (bytes == 0)
+        return -1;
+
+    spi_stream(bytes, len, ret, &queued);
 
     return 0;
-}
\ No newline at end of file
+}
+
+void spi_read_bytes(uint8_t *ret, uint32_t len)
+{
+    uint32_t queued = 0;
+
+    spi_stream(0, len, ret, &queued);
+}
+
+void spi_queue_dummy(uint32_t *queued, uint32_t len)
+{
+    if (len > SPI_FIFO_DEPTH - *queued)
+        len = SPI_FIFO_DEPTH - *queued;
+
+    // enable slave select
+    write_reg(SPI_SLAVE_SELECT_REG, 0xfffffffe);
+
+    for (uint32_t i = 0; i < len; i++)
+    {
+        write_reg(SPI_TRANSMIT_REG, 0xff);
+    }
+    *queued += len;
+}
+
+void spi_read_queued(uint8_t *ret, uint32_t len, uint32_t *queued)
+{
+    spi_stream(0, len, ret, queued);
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdint.h>
+#include "platform.h"
 
 #define SPI_BASE 0x20000000
 
@@ -16,10 +17,46 @@
 #define SPI_INTERRUPT_STATUS_REG SPI_BASE + 0x20
 #define SPI_INTERRUPT_ENABLE_REG SPI_BASE + 0x28
 
+// status register
+#define SPI_STATUS_RX_EMPTY 0x1
+#define SPI_STATUS_RX_FULL 0x2
+#define SPI_STATUS_TX_EMPTY 0x4
+#define SPI_STATUS_TX_FULL 0x8
+
+// depth of the TX and RX FIFOs (C_FIFO_DEPTH of the axi_quad_spi)
+#define SPI_FIFO_DEPTH 256
+
+// the SPI reference clock is selected by the upper bit of the GPIO output
+// channel (the lower 8 bits drive the LEDs)
+#define SPI_CLK_SEL_BIT 0x100
+
+// SCK = 12.5 MHz (identification) and 25 MHz (data transfer)
+#define SPI_CLOCK_SLOW 0
+#define SPI_CLOCK_FAST 1
+
+
+// 32-bit register access
+void write_reg(uintptr_t addr, uint32_t value);
+uint32_t read_reg(uintptr_t addr);
 
 void spi_init();
 
 uint8_t spi_txrx(uint8_t byte);
 
+// switch the SCK frequency, must only be called while the bus is idle
+void spi_set_clock(int speed);
+
+// send len bytes and store the received bytes in ret (if not NULL)
 // return -1 if something went wrong
-int spi_write_bytes(uint8_t *bytes, uint32_t len, uint8_t *ret);
\ No newline at end of file
+int spi_write_bytes(uint8_t *bytes, uint32_t len, uint8_t *ret);
+
+// receive len bytes into ret (sending 0xff)
+void spi_read_bytes(uint8_t *ret, uint32_t len);
+
+// Start clocking in len bytes (at most a FIFO full) in the background, the
+// CPU can do other work in the meantime. queued counts the bytes in flight
+// and has to be passed to spi_read_queued which returns their responses.
+void spi_queue_dummy(uint32_t *queued, uint32_t len);
+
+// like spi_read_bytes but receive the queued bytes first
+void spi_read_queued(uint8_t *ret, uint32_t len, uint32_t *queued);
@@ -2,13 +2,21 @@
 
 void write_reg_u8(uintptr_t addr, uint8_t value)
 {
+#ifdef BOOTROM_HOST
+    host_mmio_write(addr, value, 1);
+#else
     volatile uint8_t *loc_addr = (volatile uint8_t *)addr;
     *loc_addr = value;
+#endif
 }
 
 uint8_t read_reg_u8(uintptr_t addr)
 {
+#ifdef BOOTROM_HOST
+    return host_mmio_read(addr, 1);
+#else
     return *(volatile uint8_t *)addr;
+#endif
 }
 
 int is_transmit_empty()
@@ -16,11 +24,38 @@ int is_transmit_empty()
     return read_reg_u8(UART_LINE_STATUS) & 0x20;
 }
 
+// refill the transmit FIFO once it is empty
+static void uart_drain(uart_ring_t *ring)
+{
+    if (is_transmit_empty() == 0)
+        return;
+
+    for (int i = 0; i < UART_FIFO_DEPTH && ring->tail != ring->head; i++, ring->tail++)
+        write_reg_u8(UART_THR, ring->buf[ring->tail % UART_RING_SIZE]);
+}
+
 void write_serial(char a)
 {
-    while (is_transmit_empty() == 0) {};
+    uart_ring_t *ring = (uart_ring_t *)UART_RING_BASE;
+
+    // only block if the ring is full
+    while (ring->head - ring->tail == UART_RING_SIZE)
+        uart_drain(ring);
+
+    ring->buf[ring->head % UART_RING_SIZE] = a;
+    ring->head++;
 
-    write_reg_u8(UART_THR, a);
+    uart_drain(ring);
+}
+
+void uart_flush()
+{
+    uart_ring_t *ring = (uart_ring_t *)UART_RING_BASE;
+
+    while (ring->tail != ring->head)
+        uart_drain(ring);
+
+    while (is_transmit_empty() == 0) {};
 }
 
 void init_uart()
@@ -32,6 +67,10 @@ void init_uart()
     write_reg_u8(UART_LINE_CONTROL, 0x03);     // 8 bits, no parity, one stop bit
     write_reg_u8(UART_FIFO_CONTROL, 0xC7);     // Enable FIFO, clear them, with 14-byte threshold
     write_reg_u8(UART_MODEM_CONTROL, 0x20);    // Autoflow mode
+
+    uart_ring_t *ring = (uart_ring_t *)UART_RING_BASE;
+    ring->head = 0;
+    ring->tail = 0;
 }
 
 void print_uart(const char *str)
@@ -1,6 +1,15 @@
 #pragma once
 
 #include <stdint.h>
+#include "platform.h"
+
+// compile time verbosity of the bootloader, errors are always printed
+#define VERBOSITY_ERROR 0
+#define VERBOSITY_INFO 1  // boot progress
+#define VERBOSITY_DEBUG 2 // SPI status, SD command responses, GPT header
+#ifndef VERBOSITY
+#define VERBOSITY VERBOSITY_INFO
+#endif
 
 #define UART_BASE 0x10000000
 
@@ -16,8 +25,24 @@
 #define UART_DLAB_LSB UART_BASE + 0
 #define UART_DLAB_MSB UART_BASE + 4
 
+#define UART_FIFO_DEPTH 16
+
+// Characters are queued in a ring buffer and handed to the UART FIFO
+// whenever it runs empty, printing only blocks if the ring is full.
+#define UART_RING_SIZE 4096
+
+typedef struct uart_ring
+{
+    uint32_t head;
+    uint32_t tail;
+    uint8_t buf[UART_RING_SIZE];
+} uart_ring_t;
+
 void init_uart();
 
+// wait until everything has been sent
+void uart_flush();
+
 void print_uart(const char* str);
 
 void print_uart_int(uint32_t addr);
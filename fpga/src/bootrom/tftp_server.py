@@ -0,0 +1,92 @@
+#!/usr/bin/env python3
+
+# Minimal read-only TFTP server (RFC 1350 with the blksize option, RFC 2348)
+# to netboot the bootloader from a local directory, e.g. on a lab machine or
+# against the host side bootrom harness.
+
+import argparse
+import os.path
+import socket
+import struct
+import sys
+
+TFTP_RRQ = 1
+TFTP_DATA = 3
+TFTP_ACK = 4
+TFTP_ERROR = 5
+TFTP_OACK = 6
+
+parser = argparse.ArgumentParser(description='Serve files to the bootloader via TFTP')
+parser.add_argument('root', help='directory to serve')
+parser.add_argument('--address', default='0.0.0.0', help='address to listen on')
+parser.add_argument('--port', type=int, default=69, help='port to listen on')
+parser.add_argument('--timeout', type=float, default=1.0, help='retransmission timeout in seconds')
+parser.add_argument('--once', action='store_true', help='exit after the first transfer')
+
+args = parser.parse_args()
+
+def error(sock, peer, code, msg):
+    sock.sendto(struct.pack("!HH", TFTP_ERROR, code) + msg.encode() + b"\0", peer)
+
+def send(sock, peer, packet, block):
+    # retransmit until the matching ACK arrives
+    for retry in range(10):
+        sock.sendto(packet, peer)
+        try:
+            while True:
+                data, addr = sock.recvfrom(65536)
+                if addr != peer or len(data) < 4:
+                    continue
+                op, ack = struct.unpack("!HH", data[:4])
+                if op == TFTP_ACK and ack == block:
+                    return True
+                if op == TFTP_ERROR:
+                    return False
+        except socket.timeout:
+            pass
+    return False
+
+def transfer(peer, request):
+    fields = request.split(b"\0")
+    filename, mode = fields[0].decode(), fields[1].decode().lower()
+    options = dict(zip(fields[2:-1:2], fields[3::2]))
+
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.bind((args.address, 0))
+    sock.settimeout(args.timeout)
+
+    path = os.path.join(args.root, os.path.basename(filename))
+    if mode != "octet" or not os.path.isfile(path):
+        error(sock, peer, 1, "file not found")
+        return
+
+    with open(path, "rb") as f:
+        data = f.read()
+
+    blksize = 512
+    if b"blksize" in options:
+        blksize = max(8, min(int(options[b"blksize"]), 65464))
+        if not send(sock, peer, struct.pack("!H", TFTP_OACK) + b"blksize\0" + str(blksize).encode() + b"\0", 0):
+            return
+
+    # the last block is always short (possibly empty)
+    nr_blocks = len(data) // blksize + 1
+    for i in range(nr_blocks):
+        block = (i + 1) & 0xffff
+        packet = struct.pack("!HH", TFTP_DATA, block) + data[i * blksize:(i + 1) * blksize]
+        if not send(sock, peer, packet, block):
+            print("transfer of {} to {} failed".format(filename, peer))
+            return
+
+    print("sent {} ({} bytes) to {}".format(filename, len(data), peer))
+
+server = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+server.bind((args.address, args.port))
+
+while True:
+    request, peer = server.recvfrom(65536)
+    if len(request) < 4 or struct.unpack("!H", request[:2])[0] != TFTP_RRQ:
+        continue
+    transfer(peer, request[2:])
+    if args.once:
+        sys.exit(0)
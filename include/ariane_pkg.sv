@@ -30,23 +30,50 @@ package ariane_pkg;
     // ---------------
     // Global Config
     // ---------------
-    localparam NR_SB_ENTRIES = 8; // number of scoreboard entries
+`ifndef CONFIG_SB_ENTRIES
+    `define CONFIG_SB_ENTRIES 8
+`endif
+`ifndef CONFIG_NR_LOAD_PORTS
+    `define CONFIG_NR_LOAD_PORTS 1
+`endif
+    // number of scoreboard entries, 8, 16 or 32. The scoreboard limits how many
+    // instructions can be in flight, override with defines=CONFIG_SB_ENTRIES=16
+    localparam NR_SB_ENTRIES = `CONFIG_SB_ENTRIES;
     localparam TRANS_ID_BITS = $clog2(NR_SB_ENTRIES); // depending on the number of scoreboard entries we need that many bits
                                                       // to uniquely identify the entry in the scoreboard
     localparam ASID_WIDTH    = 1;
     localparam BTB_ENTRIES   = 64;
+    localparam BTB_WAYS      = 4; // BTB_ENTRIES / BTB_WAYS sets with LRU replacement
+    localparam BTB_TAG_BITS  = 8; // partial tag compared on every BTB lookup
+    // predict indirect jumps with the targets of the preceding indirect jumps
+    // in addition to the BTB, compare with the CSR_BTB_MIS_PREDICT counter
+    localparam bit INDIRECT_PREDICTOR = 1'b1;
+    localparam INDIRECT_ENTRIES     = 64;
+    localparam PATH_HISTORY_BITS    = 6; // two bits per target, at most $clog2(INDIRECT_ENTRIES)
     localparam BHT_ENTRIES   = 128;
-    localparam RAS_DEPTH     = 2;
+    // index the BHT with the PC xor'ed with the global branch history (gshare)
+    // instead of the PC alone, compare with the CSR_BHT_MIS_PREDICT counter
+    localparam bit BHT_GSHARE       = 1'b0;
+    localparam BHT_HISTORY_BITS     = 7; // at most $clog2(BHT_ENTRIES)
+    localparam RAS_DEPTH     = 8; // at least 2
     localparam BITS_SATURATION_COUNTER = 2;
     localparam NR_COMMIT_PORTS = 2;
 
     localparam ENABLE_RENAME = 1'b0;
 
+    // 1 or 2, the second issue lane only takes integer ALU instructions
+    // which go to a dedicated ALU with its own write-back port
     localparam ISSUE_WIDTH = 1;
     // amount of pipeline registers inserted for load/store return path
     // this can be tuned to trade-off IPC vs. cycle time
     localparam NR_LOAD_PIPE_REGS = 1;
     localparam NR_STORE_PIPE_REGS = 0;
+    // D$ ports of the load unit, it can have one request outstanding on each of them so that
+    // a miss doesn't block the following loads. 1 or 2, the bypass AXI ID of the std cache
+    // has two bits for the D$ port, override with defines=CONFIG_NR_LOAD_PORTS=2
+    localparam int unsigned NR_LOAD_PORTS = `CONFIG_NR_LOAD_PORTS;
+    // port 0 is the PTW, then come the load ports and the store unit is last
+    localparam int unsigned NR_DCACHE_PORTS = NR_LOAD_PORTS + 2;
 
     // depth of store-buffers, this needs to be a power of two
     localparam int unsigned DEPTH_SPEC   = 4;
@@ -119,7 +146,7 @@ package ariane_pkg;
 
     // 32 registers + 1 bit for re-naming = 6
     localparam REG_ADDR_SIZE = 6;
-    localparam NR_WB_PORTS = 4;
+    localparam NR_WB_PORTS = 4 + ISSUE_WIDTH - 1; // FLU, load, store, FPU and the ALU of the second issue lane
 
     // static debug hartinfo
     localparam dm::hartinfo_t DebugHartInfo = '{
@@ -186,7 +213,15 @@ package ariane_pkg;
          logic        valid;
     } exception_t;
 
-    typedef enum logic [1:0] { BHT, BTB, RAS } cf_t;
+    // control flow change predicted by the BHT, the BTB or the RAS, NO_CF for
+    // jumps and instructions without a (valid) prediction
+    typedef enum logic [1:0] { NO_CF, BHT, BTB, RAS } cf_t;
+
+    // RAS state which is restored on a mis-predict: top of stack and number of valid entries
+    typedef struct packed {
+        logic [$clog2(RAS_DEPTH)-1:0]   tos;
+        logic [$clog2(RAS_DEPTH+1)-1:0] cnt;
+    } ras_ptr_t;
 
     // branch-predict
     // this is the struct we get back from ex stage and we will use it to update
@@ -200,6 +235,9 @@ package ariane_pkg;
         logic        valid;           // prediction with all its values is valid
         logic        clear;           // invalidate this entry
         cf_t         cf_type;         // Type of control flow change
+        logic [BHT_HISTORY_BITS-1:0] history; // global history the prediction has been made with
+        ras_ptr_t    ras_ptr;         // RAS top of stack and occupancy after the fetch
+        logic [PATH_HISTORY_BITS-1:0] path_history; // indirect jump targets the prediction has been made with
     } branchpredict_t;
 
     // branchpredict scoreboard entry
@@ -211,6 +249,9 @@ package ariane_pkg;
         logic        predict_taken;   // branch is taken
                                       // in the lower 16 bit of the word
         cf_t         cf_type;         // Type of control flow change
+        logic [BHT_HISTORY_BITS-1:0] history; // global history at the time of the prediction
+        ras_ptr_t    ras_ptr;         // RAS top of stack and occupancy after the fetch
+        logic [PATH_HISTORY_BITS-1:0] path_history; // indirect jump targets at the time of the prediction
     } branchpredict_sbe_t;
 
     typedef struct packed {
@@ -218,6 +259,8 @@ package ariane_pkg;
         logic [63:0] pc;             // update at PC
         logic [63:0] target_address;
         logic        clear;
+        logic        mispredict;
+        logic [PATH_HISTORY_BITS-1:0] path_history; // indirect jump targets the prediction has been made with
     } btb_update_t;
 
     typedef struct packed {
@@ -235,6 +278,7 @@ package ariane_pkg;
         logic [63:0] pc;          // update at PC
         logic        mispredict;
         logic        taken;
+        logic [BHT_HISTORY_BITS-1:0] history; // global history the prediction has been made with
     } bht_update_t;
 
     typedef struct packed {
@@ -442,6 +486,7 @@ package ariane_pkg;
     typedef struct packed {
         logic                     valid;
         logic [63:0]              vaddr;
+        logic [63:0]              pc;
         logic [63:0]              data;
         logic [7:0]               be;
         fu_t                      fu;
@@ -598,6 +643,13 @@ package ariane_pkg;
         logic [63:0]                   data_rdata;
     } dcache_req_o_t;
 
+    // loads the D$ prefetcher learns the strides from
+    typedef struct packed {
+        logic                          valid;
+        logic [63:0]                   pc;
+        logic [55:0]                   paddr;
+    } dcache_train_t;
+
     // ----------------------
     // Arithmetic Functions
     // ----------------------
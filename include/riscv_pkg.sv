@@ -386,7 +386,19 @@ package riscv;
         CSR_RET            = 12'hC0D,  // Procedure Return
         CSR_MIS_PREDICT    = 12'hC0E,  // Branch mis-predicted
         CSR_SB_FULL        = 12'hC0F,  // Scoreboard full
-        CSR_IF_EMPTY       = 12'hC10   // instruction fetch queue empty
+        CSR_IF_EMPTY       = 12'hC10,  // instruction fetch queue empty
+        CSR_BHT_MIS_PREDICT = 12'hC11, // Conditional branch mis-predicted
+        CSR_RAS_HIT        = 12'hC12,  // Return correctly predicted by the RAS
+        CSR_RAS_MISS       = 12'hC13,  // Return mis-predicted by the RAS
+        CSR_BTB_MIS_PREDICT = 12'hC14, // Indirect jump target mis-predicted
+        CSR_SB_OCC_Q0      = 12'hC15,  // Scoreboard less than a quarter full
+        CSR_SB_OCC_Q1      = 12'hC16,  // Scoreboard a quarter to half full
+        CSR_SB_OCC_Q2      = 12'hC17,  // Scoreboard half to three quarters full
+        CSR_SB_OCC_Q3      = 12'hC18,  // Scoreboard more than three quarters full
+        CSR_LD_FORWARD     = 12'hC19,  // Load got data from the store buffer
+        CSR_LD_ST_STALL    = 12'hC1A,  // Load waited for the store buffer to drain
+        CSR_L1_DCACHE_PREFETCH = 12'hC1B, // L1 Data Cache line prefetched
+        CSR_L1_DCACHE_PREFETCH_HIT = 12'hC1C // Load accessed a prefetched line
     } csr_reg_t;
 
     localparam logic [63:0] SSTATUS_UIE  = 64'h00000001;
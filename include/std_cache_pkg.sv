@@ -22,10 +22,27 @@ package std_cache_pkg;
     localparam DCACHE_NUM_WORDS   = 2**(ariane_pkg::DCACHE_INDEX_WIDTH-DCACHE_BYTE_OFFSET);
     localparam DCACHE_DIRTY_WIDTH = ariane_pkg::DCACHE_SET_ASSOC*2;
     // localparam DECISION_BIT = 30; // bit on which to decide whether the request is cache-able or not
+    // number of lines following an I$ miss which are prefetched into the stream buffer, 0 disables it
+    localparam ICACHE_PREFETCH_LINES = 2;
+`ifndef CONFIG_DCACHE_PREFETCH_ENTRIES
+    `define CONFIG_DCACHE_PREFETCH_ENTRIES 0
+`endif
+    // entries of the PC-indexed stride prefetcher of the D$, 0 disables it. Off by default,
+    // override with defines=CONFIG_DCACHE_PREFETCH_ENTRIES=16
+    localparam DCACHE_PREFETCH_ENTRIES = `CONFIG_DCACHE_PREFETCH_ENTRIES;
+`ifndef CONFIG_REFILL_CRITICAL_WORD_FIRST
+    `define CONFIG_REFILL_CRITICAL_WORD_FIRST 0
+`endif
+    // refill lines of the cached region with a wrapping burst which starts at the word that
+    // missed, main memory needs to support wrapping bursts (see tb/common/axi_wrap_split.sv),
+    // off until the FPGA memory path has been verified, override with
+    // defines=CONFIG_REFILL_CRITICAL_WORD_FIRST=1
+    localparam logic REFILL_CRITICAL_WORD_FIRST = `CONFIG_REFILL_CRITICAL_WORD_FIRST;
 
     typedef struct packed {
-        logic [1:0]      id;     // id for which we handle the miss
+        logic [$clog2(ariane_pkg::NR_DCACHE_PORTS)-1:0] id; // id for which we handle the miss
         logic            valid;
+        logic            prefetch; // refill for the prefetcher, nobody is waiting for it
         logic            we;
         logic [55:0]     addr;
         logic [7:0][7:0] wdata;
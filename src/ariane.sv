@@ -85,10 +85,10 @@ module ariane #(
   // --------------
   // ID <-> ISSUE
   // --------------
-  scoreboard_entry_t        issue_entry_id_issue;
-  logic                     issue_entry_valid_id_issue;
+  scoreboard_entry_t [ISSUE_WIDTH-1:0] issue_entry_id_issue;
+  logic [ISSUE_WIDTH-1:0]   issue_entry_valid_id_issue;
   logic                     is_ctrl_fow_id_issue;
-  logic                     issue_instr_issue_id;
+  logic [ISSUE_WIDTH-1:0]   issue_instr_issue_id;
 
   // --------------
   // ISSUE <-> EX
@@ -104,6 +104,12 @@ module ariane #(
   exception_t               flu_exception_ex_id;
   // ALU
   logic                     alu_valid_id_ex;
+  // ALU of the second issue lane
+  fu_data_t                 alu2_fu_data_id_ex;
+  logic                     alu2_valid_id_ex;
+  logic [TRANS_ID_BITS-1:0] alu2_trans_id_ex_id;
+  logic [63:0]              alu2_result_ex_id;
+  logic                     alu2_valid_ex_id;
   // Branches and Jumps
   logic                     branch_valid_id_ex;
 
@@ -135,6 +141,11 @@ module ariane #(
   exception_t               fpu_exception_ex_id;
   // CSR
   logic                     csr_valid_id_ex;
+  // write-back ports into the scoreboard
+  logic [NR_WB_PORTS-1:0][TRANS_ID_BITS-1:0] trans_id_ex_id;
+  logic [NR_WB_PORTS-1:0][63:0]              wbdata_ex_id;
+  exception_t [NR_WB_PORTS-1:0]              ex_ex_ex_id;
+  logic [NR_WB_PORTS-1:0]                    wb_valid_ex_id;
   // --------------
   // EX <-> COMMIT
   // --------------
@@ -195,7 +206,11 @@ module ariane #(
   logic                     icache_flush_ctrl_cache;
   logic                     itlb_miss_ex_perf;
   logic                     dtlb_miss_ex_perf;
+  logic                     ld_forward_ex_perf;
+  logic                     ld_stall_ex_perf;
   logic                     dcache_miss_cache_perf;
+  logic                     dcache_prefetch_cache_perf;
+  logic                     dcache_prefetch_hit_cache_perf;
   logic                     icache_miss_cache_perf;
   // --------------
   // CTRL <-> *
@@ -225,6 +240,7 @@ module ariane #(
   amo_req_t                 amo_req;
   amo_resp_t                amo_resp;
   logic                     sb_full;
+  logic [TRANS_ID_BITS-1:0] sb_occupancy;
 
   logic debug_req;
   // Disable debug during AMO commit
@@ -233,8 +249,9 @@ module ariane #(
   // ----------------
   // DCache <-> *
   // ----------------
-  dcache_req_i_t [2:0]      dcache_req_ports_ex_cache;
-  dcache_req_o_t [2:0]      dcache_req_ports_cache_ex;
+  dcache_req_i_t [NR_DCACHE_PORTS-1:0] dcache_req_ports_ex_cache;
+  dcache_req_o_t [NR_DCACHE_PORTS-1:0] dcache_req_ports_cache_ex;
+  dcache_train_t            dcache_train_ex_cache;
   logic                     dcache_commit_wbuffer_empty;
 
   // --------------
@@ -298,6 +315,7 @@ module ariane #(
     .clk_i,
     .rst_ni,
     .sb_full_o                  ( sb_full                      ),
+    .sb_occupancy_o             ( sb_occupancy                 ),
     .flush_unissued_instr_i     ( flush_unissued_instr_ctrl_id ),
     .flush_i                    ( flush_ctrl_id                ),
     // ID Stage
@@ -313,6 +331,8 @@ module ariane #(
     .flu_ready_i                ( flu_ready_ex_id              ),
     // ALU
     .alu_valid_o                ( alu_valid_id_ex              ),
+    .alu2_fu_data_o             ( alu2_fu_data_id_ex           ),
+    .alu2_valid_o               ( alu2_valid_id_ex             ),
     // Branches and Jumps
     .branch_valid_o             ( branch_valid_id_ex           ), // branch is valid
     .branch_predict_o           ( branch_predict_id_ex         ), // branch predict to ex
@@ -331,10 +351,10 @@ module ariane #(
     .csr_valid_o                ( csr_valid_id_ex              ),
     // Commit
     .resolved_branch_i          ( resolved_branch              ),
-    .trans_id_i                 ( {flu_trans_id_ex_id,  load_trans_id_ex_id,  store_trans_id_ex_id,   fpu_trans_id_ex_id }),
-    .wbdata_i                   ( {flu_result_ex_id,    load_result_ex_id,    store_result_ex_id,       fpu_result_ex_id }),
-    .ex_ex_i                    ( {flu_exception_ex_id, load_exception_ex_id, store_exception_ex_id, fpu_exception_ex_id }),
-    .wb_valid_i                 ( {flu_valid_ex_id,     load_valid_ex_id,     store_valid_ex_id,         fpu_valid_ex_id }),
+    .trans_id_i                 ( trans_id_ex_id               ),
+    .wbdata_i                   ( wbdata_ex_id                 ),
+    .ex_ex_i                    ( ex_ex_ex_id                  ),
+    .wb_valid_i                 ( wb_valid_ex_id               ),
 
     .waddr_i                    ( waddr_commit_id              ),
     .wdata_i                    ( wdata_commit_id              ),
@@ -345,10 +365,27 @@ module ariane #(
     .*
   );
 
+  assign trans_id_ex_id[3:0] = {flu_trans_id_ex_id,  load_trans_id_ex_id,  store_trans_id_ex_id,   fpu_trans_id_ex_id };
+  assign wbdata_ex_id[3:0]   = {flu_result_ex_id,    load_result_ex_id,    store_result_ex_id,       fpu_result_ex_id };
+  assign ex_ex_ex_id[3:0]    = {flu_exception_ex_id, load_exception_ex_id, store_exception_ex_id, fpu_exception_ex_id };
+  assign wb_valid_ex_id[3:0] = {flu_valid_ex_id,     load_valid_ex_id,     store_valid_ex_id,         fpu_valid_ex_id };
+
+  // the second issue lane writes back through its own port
+  generate
+    if (ISSUE_WIDTH > 1) begin : gen_alu2_wb
+      assign trans_id_ex_id[4] = alu2_trans_id_ex_id;
+      assign wbdata_ex_id[4]   = alu2_result_ex_id;
+      assign ex_ex_ex_id[4]    = '0;
+      assign wb_valid_ex_id[4] = alu2_valid_ex_id;
+    end
+  endgenerate
+
   // ---------
   // EX
   // ---------
-  ex_stage ex_stage_i (
+  ex_stage #(
+    .CACHE_START_ADDR       ( CachedAddrBeg               )
+  ) ex_stage_i (
     .clk_i                  ( clk_i                       ),
     .rst_ni                 ( rst_ni                      ),
     .flush_i                ( flush_ctrl_ex               ),
@@ -363,6 +400,11 @@ module ariane #(
     .flu_ready_o            ( flu_ready_ex_id             ),
     // ALU
     .alu_valid_i            ( alu_valid_id_ex             ),
+    .alu2_fu_data_i         ( alu2_fu_data_id_ex          ),
+    .alu2_valid_i           ( alu2_valid_id_ex            ),
+    .alu2_result_o          ( alu2_result_ex_id           ),
+    .alu2_trans_id_o        ( alu2_trans_id_ex_id         ),
+    .alu2_valid_o           ( alu2_valid_ex_id            ),
     // Branches and Jumps
     .branch_valid_i         ( branch_valid_id_ex          ),
     .branch_predict_i       ( branch_predict_id_ex        ), // branch predict to ex
@@ -408,6 +450,8 @@ module ariane #(
     // Performance counters
     .itlb_miss_o            ( itlb_miss_ex_perf           ),
     .dtlb_miss_o            ( dtlb_miss_ex_perf           ),
+    .ld_forward_o           ( ld_forward_ex_perf          ),
+    .ld_stall_o             ( ld_stall_ex_perf            ),
     // Memory Management
     .enable_translation_i   ( enable_translation_csr_ex   ), // from CSR
     .en_ld_st_translation_i ( en_ld_st_translation_csr_ex ),
@@ -422,7 +466,8 @@ module ariane #(
     .icache_areq_o          ( icache_areq_ex_cache        ),
     // DCACHE interfaces
     .dcache_req_ports_i     ( dcache_req_ports_cache_ex   ),
-    .dcache_req_ports_o     ( dcache_req_ports_ex_cache   )
+    .dcache_req_ports_o     ( dcache_req_ports_ex_cache   ),
+    .dcache_train_o         ( dcache_train_ex_cache       )
   );
 
   // ---------
@@ -526,25 +571,30 @@ module ariane #(
   // Performance Counters
   // ------------------------
   perf_counters i_perf_counters (
-    .clk_i             ( clk_i                  ),
-    .rst_ni            ( rst_ni                 ),
-    .debug_mode_i      ( debug_mode             ),
-    .addr_i            ( addr_csr_perf          ),
-    .we_i              ( we_csr_perf            ),
-    .data_i            ( data_csr_perf          ),
-    .data_o            ( data_perf_csr          ),
-    .commit_instr_i    ( commit_instr_id_commit ),
-    .commit_ack_i      ( commit_ack             ),
-
-    .l1_icache_miss_i  ( icache_miss_cache_perf ),
-    .l1_dcache_miss_i  ( dcache_miss_cache_perf ),
-    .itlb_miss_i       ( itlb_miss_ex_perf      ),
-    .dtlb_miss_i       ( dtlb_miss_ex_perf      ),
-    .sb_full_i         ( sb_full                ),
-    .if_empty_i        ( ~fetch_valid_if_id     ),
-    .ex_i              ( ex_commit              ),
-    .eret_i            ( eret                   ),
-    .resolved_branch_i ( resolved_branch        )
+    .clk_i                    ( clk_i                          ),
+    .rst_ni                   ( rst_ni                         ),
+    .debug_mode_i             ( debug_mode                     ),
+    .addr_i                   ( addr_csr_perf                  ),
+    .we_i                     ( we_csr_perf                    ),
+    .data_i                   ( data_csr_perf                  ),
+    .data_o                   ( data_perf_csr                  ),
+    .commit_instr_i           ( commit_instr_id_commit         ),
+    .commit_ack_i             ( commit_ack                     ),
+
+    .l1_icache_miss_i         ( icache_miss_cache_perf         ),
+    .l1_dcache_miss_i         ( dcache_miss_cache_perf         ),
+    .l1_dcache_prefetch_i     ( dcache_prefetch_cache_perf     ),
+    .l1_dcache_prefetch_hit_i ( dcache_prefetch_hit_cache_perf ),
+    .itlb_miss_i              ( itlb_miss_ex_perf              ),
+    .dtlb_miss_i              ( dtlb_miss_ex_perf              ),
+    .ld_forward_i             ( ld_forward_ex_perf             ),
+    .ld_stall_i               ( ld_stall_ex_perf               ),
+    .sb_full_i                ( sb_full                        ),
+    .sb_occupancy_i           ( sb_occupancy                   ),
+    .if_empty_i               ( ~fetch_valid_if_id             ),
+    .ex_i                     ( ex_commit                      ),
+    .eret_i                   ( eret                           ),
+    .resolved_branch_i        ( resolved_branch                )
   );
 
   // ------------
@@ -609,8 +659,11 @@ module ariane #(
     .dcache_amo_resp_o     ( amo_resp                    ),
     // from PTW, Load Unit  and Store Unit
     .dcache_miss_o         ( dcache_miss_cache_perf      ),
+    .dcache_prefetch_o     ( dcache_prefetch_cache_perf  ),
+    .dcache_prefetch_hit_o ( dcache_prefetch_hit_cache_perf ),
     .dcache_req_ports_i    ( dcache_req_ports_ex_cache   ),
     .dcache_req_ports_o    ( dcache_req_ports_cache_ex   ),
+    .dcache_train_i        ( dcache_train_ex_cache       ),
     // write buffer status
     .wbuffer_empty_o       ( dcache_commit_wbuffer_empty ),
 `ifdef AXI64_CACHE_PORTS
@@ -647,11 +700,14 @@ module ariane #(
     .amo_req_i             ( amo_req                     ),
     .amo_resp_o            ( amo_resp                    ),
     .dcache_miss_o         ( dcache_miss_cache_perf      ),
+    .dcache_prefetch_o     ( dcache_prefetch_cache_perf  ),
+    .dcache_prefetch_hit_o ( dcache_prefetch_hit_cache_perf ),
     // this is statically set to 1 as the std_cache does not have a wbuffer
     .wbuffer_empty_o       ( dcache_commit_wbuffer_empty ),
     // from PTW, Load Unit  and Store Unit
     .dcache_req_ports_i    ( dcache_req_ports_ex_cache   ),
     .dcache_req_ports_o    ( dcache_req_ports_cache_ex   ),
+    .dcache_train_i        ( dcache_train_ex_cache       ),
     // memory side
     .axi_req_o             ( axi_req_o                   ),
     .axi_resp_i            ( axi_resp_i                  )
@@ -691,8 +747,8 @@ module ariane #(
   assign tracer_if.st_valid          = ex_stage_i.lsu_i.i_store_unit.store_buffer_i.valid_i;
   assign tracer_if.st_paddr          = ex_stage_i.lsu_i.i_store_unit.store_buffer_i.paddr_i;
   // loads
-  assign tracer_if.ld_valid          = ex_stage_i.lsu_i.i_load_unit.req_port_o.tag_valid;
-  assign tracer_if.ld_kill           = ex_stage_i.lsu_i.i_load_unit.req_port_o.kill_req;
+  assign tracer_if.ld_valid          = ex_stage_i.lsu_i.i_load_unit.tag_valid;
+  assign tracer_if.ld_kill           = ex_stage_i.lsu_i.i_load_unit.kill_req;
   assign tracer_if.ld_paddr          = ex_stage_i.lsu_i.i_load_unit.paddr_i;
   // exceptions
   assign tracer_if.exception         = commit_stage_i.exception_o;
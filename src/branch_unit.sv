@@ -45,6 +45,9 @@ module branch_unit (
         resolved_branch_o.is_mispredict  = 1'b0;
         resolved_branch_o.clear          = 1'b0;
         resolved_branch_o.cf_type        = branch_predict_i.cf_type;
+        resolved_branch_o.history        = branch_predict_i.history;
+        resolved_branch_o.ras_ptr        = branch_predict_i.ras_ptr;
+        resolved_branch_o.path_history   = branch_predict_i.path_history;
         // calculate next PC, depending on whether the instruction is compressed or not this may be different
         next_pc                          = pc_i + ((is_compressed_instr_i) ? 64'h2 : 64'h4);
         // calculate target address simple 64 bit addition
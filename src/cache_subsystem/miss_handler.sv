@@ -47,6 +47,13 @@ module miss_handler #(
     output ariane_axi::req_t                            axi_data_o,
     input  ariane_axi::resp_t                           axi_data_i,
 
+    // Prefetch (~> cacheline refill nobody is waiting for)
+    input  logic                                        prefetch_req_i,
+    input  logic [55:0]                                 prefetch_addr_i,
+    output logic                                        prefetch_gnt_o,
+    output logic                                        prefetch_refill_o,      // the prefetched line is being refilled
+    output logic [55:0]                                 prefetch_refill_addr_o,
+
     input  logic [NR_PORTS-1:0][55:0]                   mshr_addr_i,
     output logic [NR_PORTS-1:0]                         mshr_addr_matches_o,
     output logic [NR_PORTS-1:0]                         mshr_index_matches_o,
@@ -128,11 +135,12 @@ module miss_handler #(
     // Cache Management
     // ------------------------------
     always_comb begin : cache_management
-        automatic logic [DCACHE_SET_ASSOC-1:0] evict_way, valid_way;
+        automatic logic [DCACHE_SET_ASSOC-1:0] evict_way, valid_way, hit_way;
 
         for (int unsigned i = 0; i < DCACHE_SET_ASSOC; i++) begin
             evict_way[i] = data_i[i].valid & data_i[i].dirty;
             valid_way[i] = data_i[i].valid;
+            hit_way[i]   = data_i[i].valid && data_i[i].tag == mshr_q.addr[DCACHE_TAG_WIDTH+DCACHE_INDEX_WIDTH-1:DCACHE_INDEX_WIDTH];
         end
         // ----------------------
         // Default Assignments
@@ -145,6 +153,9 @@ module miss_handler #(
         we_o   = '0;
         // Cache controller
         miss_gnt_o = '0;
+        // Prefetcher
+        prefetch_gnt_o    = 1'b0;
+        prefetch_refill_o = 1'b0;
         // LFSR replacement unit
         lfsr_enable = 1'b0;
         // to AXI refill
@@ -168,7 +179,7 @@ module miss_handler #(
         evict_cl_d   = evict_cl_q;
         mshr_d       = mshr_q;
         // communicate to the requester which unit we are currently serving
-        active_serving_o[mshr_q.id] = mshr_q.valid;
+        active_serving_o[mshr_q.id] = mshr_q.valid && !mshr_q.prefetch;
         // AMOs
         amo_resp_o.ack = 1'b0;
         amo_resp_o.result = '0;
@@ -208,15 +219,28 @@ module miss_handler #(
                         // we are taking another request so don't take the AMO
                         serve_amo_d  = 1'b0;
                         // save to MSHR
-                        mshr_d.valid = 1'b1;
-                        mshr_d.we    = miss_req_we[i];
-                        mshr_d.id    = i;
-                        mshr_d.addr  = miss_req_addr[i][DCACHE_TAG_WIDTH+DCACHE_INDEX_WIDTH-1:0];
-                        mshr_d.wdata = miss_req_wdata[i];
-                        mshr_d.be    = miss_req_be[i];
+                        mshr_d.valid    = 1'b1;
+                        mshr_d.prefetch = 1'b0;
+                        mshr_d.we       = miss_req_we[i];
+                        mshr_d.id       = i;
+                        mshr_d.addr     = miss_req_addr[i][DCACHE_TAG_WIDTH+DCACHE_INDEX_WIDTH-1:0];
+                        mshr_d.wdata    = miss_req_wdata[i];
+                        mshr_d.be       = miss_req_be[i];
                         break;
                     end
                 end
+
+                // prefetches have the lowest priority, only take them if nobody else needs us
+                if (prefetch_req_i && state_d == IDLE && !amo_req_i.req && !flush_i) begin
+                    state_d         = MISS;
+                    prefetch_gnt_o  = 1'b1;
+                    mshr_d.valid    = 1'b1;
+                    mshr_d.prefetch = 1'b1;
+                    mshr_d.we       = 1'b0;
+                    mshr_d.id       = '0;
+                    mshr_d.addr     = prefetch_addr_i[DCACHE_TAG_WIDTH+DCACHE_INDEX_WIDTH-1:0];
+                    mshr_d.be       = '0;
+                end
             end
 
             //  ~> we missed on the cache
@@ -226,13 +250,19 @@ module miss_handler #(
                 req_o = '1;
                 addr_o = mshr_q.addr[DCACHE_INDEX_WIDTH-1:0];
                 state_d = MISS_REPL;
-                miss_o = 1'b1;
+                // prefetches are no misses
+                miss_o = !mshr_q.prefetch;
             end
 
             // ~> second miss cycle
             MISS_REPL: begin
+                // the prefetched line is already in the cache (the cache controllers make sure that
+                // this is not the case for a real miss)
+                if (mshr_q.prefetch && |hit_way) begin
+                    mshr_d.valid = 1'b0;
+                    state_d = IDLE;
                 // if all are valid we need to evict one, pseudo random from LFSR
-                if (&valid_way) begin
+                end else if (&valid_way) begin
                     lfsr_enable = 1'b1;
                     evict_way_d = lfsr_oh;
                     // do we need to write back the cache line?
@@ -259,7 +289,9 @@ module miss_handler #(
 
                 if (gnt_miss_fsm) begin
                     state_d = SAVE_CACHELINE;
-                    miss_gnt_o[mshr_q.id] = 1'b1;
+                    // nobody is waiting for a prefetch
+                    miss_gnt_o[mshr_q.id] = !mshr_q.prefetch;
+                    prefetch_refill_o     = mshr_q.prefetch;
                 end
             end
 
@@ -466,6 +498,8 @@ module miss_handler #(
         endcase
     end
 
+    assign prefetch_refill_addr_o = mshr_q.addr;
+
     // check MSHR for aliasing
     always_comb begin
 
@@ -512,6 +546,12 @@ module miss_handler #(
     // assert that cache only hits on one way
     assert property (
       @(posedge clk_i) $onehot0(evict_way_q)) else $warning("Evict-way should be one-hot encoded");
+
+    initial begin
+      // the bypass AXI ID is {2'b10, port}, see also the ID decoding in std_cache_subsystem
+      assert (NR_PORTS <= 4)
+        else $fatal(1, "[miss handler] at most 4 ports are supported (NR_LOAD_PORTS <= 2)");
+    end
     `endif
     //pragma translate_on
     // ----------------------
@@ -591,9 +631,10 @@ module miss_handler #(
     // Cache Line AXI Refill
     // ----------------------
     axi_adapter  #(
-        .DATA_WIDTH            ( DCACHE_LINE_WIDTH  ),
-        .AXI_ID_WIDTH          ( 4                  ),
-        .CACHELINE_BYTE_OFFSET ( DCACHE_BYTE_OFFSET )
+        .DATA_WIDTH            ( DCACHE_LINE_WIDTH          ),
+        .CRITICAL_WORD_FIRST   ( REFILL_CRITICAL_WORD_FIRST ),
+        .AXI_ID_WIDTH          ( 4                          ),
+        .CACHELINE_BYTE_OFFSET ( DCACHE_BYTE_OFFSET         )
     ) i_miss_axi_adapter (
         .clk_i,
         .rst_ni,
@@ -47,12 +47,15 @@ module serpent_cache_subsystem #(
   input  logic                           dcache_flush_i,         // high until acknowledged
   output logic                           dcache_flush_ack_o,     // send a single cycle acknowledge signal when the cache is flushed
   output logic                           dcache_miss_o,          // we missed on a ld/st
+  output logic                           dcache_prefetch_o,      // statically set to 0, there is no prefetcher in this cache system
+  output logic                           dcache_prefetch_hit_o,  // statically set to 0, there is no prefetcher in this cache system
   // AMO interface
   input amo_req_t                        dcache_amo_req_i,
   output amo_resp_t                      dcache_amo_resp_o,
   // Request ports
-  input  dcache_req_i_t   [2:0]          dcache_req_ports_i,     // to/from LSU
-  output dcache_req_o_t   [2:0]          dcache_req_ports_o,     // to/from LSU
+  input  dcache_req_i_t   [NR_DCACHE_PORTS-1:0] dcache_req_ports_i, // to/from LSU
+  output dcache_req_o_t   [NR_DCACHE_PORTS-1:0] dcache_req_ports_o, // to/from LSU
+  input  dcache_train_t                  dcache_train_i,         // from LSU, not used
   // writebuffer status
   output logic                           wbuffer_empty_o,
 `ifdef AXI64_CACHE_PORTS
@@ -137,6 +140,10 @@ serpent_dcache #(
     .mem_data_o      ( dcache_adapter          )
   );
 
+// the write-through dcache does not prefetch, dcache_train_i is not used
+assign dcache_prefetch_o     = 1'b0;
+assign dcache_prefetch_hit_o = 1'b0;
+
 
 // arbiter/adapter
 serpent_l15_adapter #(
@@ -319,12 +326,12 @@ else $warning(1,"[l1 dcache] reading invalid instructions: vaddr=%08X, data=%08X
   icache_dreq_o.vaddr, icache_dreq_o.data);
 
 a_invalid_write_data: assert property (
-  @(posedge clk_i) disable iff (~rst_ni) dcache_req_ports_i[2].data_req |-> |dcache_req_ports_i[2].data_be |-> (|dcache_req_ports_i[2].data_wdata) !== 1'hX)
+  @(posedge clk_i) disable iff (~rst_ni) dcache_req_ports_i[NR_DCACHE_PORTS-1].data_req |-> |dcache_req_ports_i[NR_DCACHE_PORTS-1].data_be |-> (|dcache_req_ports_i[NR_DCACHE_PORTS-1].data_wdata) !== 1'hX)
 else $warning(1,"[l1 dcache] writing invalid data: paddr=%016X, be=%02X, data=%016X",
-  {dcache_req_ports_i[2].address_tag, dcache_req_ports_i[2].address_index}, dcache_req_ports_i[2].data_be, dcache_req_ports_i[2].data_wdata);
+  {dcache_req_ports_i[NR_DCACHE_PORTS-1].address_tag, dcache_req_ports_i[NR_DCACHE_PORTS-1].address_index}, dcache_req_ports_i[NR_DCACHE_PORTS-1].data_be, dcache_req_ports_i[NR_DCACHE_PORTS-1].data_wdata);
 
 
-for(genvar j=0; j<2; j++) begin : g_assertion
+for(genvar j=0; j<NR_DCACHE_PORTS-1; j++) begin : g_assertion
   a_invalid_read_data: assert property (
     @(posedge clk_i) disable iff (~rst_ni) dcache_req_ports_o[j].data_rvalid |-> (|dcache_req_ports_o[j].data_rdata) !== 1'hX)
   else $warning(1,"[l1 dcache] reading invalid data on port %01d: data=%016X",
@@ -42,10 +42,13 @@ module std_cache_subsystem #(
     input  logic                           dcache_flush_i,         // high until acknowledged
     output logic                           dcache_flush_ack_o,     // send a single cycle acknowledge signal when the cache is flushed
     output logic                           dcache_miss_o,          // we missed on a ld/st
+    output logic                           dcache_prefetch_o,      // a line is prefetched, to performance counter
+    output logic                           dcache_prefetch_hit_o,  // a load accessed a prefetched line, to performance counter
     output logic                           wbuffer_empty_o,        // statically set to 1, as there is no wbuffer in this cache system
     // Request ports
-    input  dcache_req_i_t   [2:0]          dcache_req_ports_i,     // to/from LSU
-    output dcache_req_o_t   [2:0]          dcache_req_ports_o,     // to/from LSU
+    input  dcache_req_i_t   [NR_DCACHE_PORTS-1:0] dcache_req_ports_i, // to/from LSU
+    output dcache_req_o_t   [NR_DCACHE_PORTS-1:0] dcache_req_ports_o, // to/from LSU
+    input  dcache_train_t                  dcache_train_i,         // from LSU, trains the prefetcher
     // memory side
     output ariane_axi::req_t               axi_req_o,
     input  ariane_axi::resp_t              axi_resp_i
@@ -60,7 +63,9 @@ module std_cache_subsystem #(
     ariane_axi::req_t  axi_req_data;
     ariane_axi::resp_t axi_resp_data;
 
-    std_icache i_icache (
+    std_icache #(
+        .CACHE_START_ADDR ( CACHE_START_ADDR )
+    ) i_icache (
         .clk_i      ( clk_i                 ),
         .rst_ni     ( rst_ni                ),
         .priv_lvl_i ( priv_lvl_i            ),
@@ -77,23 +82,26 @@ module std_cache_subsystem #(
 
    // decreasing priority
    // Port 0: PTW
-   // Port 1: Load Unit
-   // Port 2: Store Unit
+   // Port 1 to NR_LOAD_PORTS: Load Unit
+   // Port NR_DCACHE_PORTS-1: Store Unit
    std_nbdcache #(
       .CACHE_START_ADDR ( CACHE_START_ADDR )
    ) i_nbdcache (
       .clk_i,
       .rst_ni,
-      .enable_i     ( dcache_enable_i        ),
-      .flush_i      ( dcache_flush_i         ),
-      .flush_ack_o  ( dcache_flush_ack_o     ),
-      .miss_o       ( dcache_miss_o          ),
-      .axi_bypass_o ( axi_req_bypass         ),
-      .axi_bypass_i ( axi_resp_bypass        ),
-      .axi_data_o   ( axi_req_data           ),
-      .axi_data_i   ( axi_resp_data          ),
-      .req_ports_i  ( dcache_req_ports_i     ),
-      .req_ports_o  ( dcache_req_ports_o     ),
+      .enable_i       ( dcache_enable_i        ),
+      .flush_i        ( dcache_flush_i         ),
+      .flush_ack_o    ( dcache_flush_ack_o     ),
+      .miss_o         ( dcache_miss_o          ),
+      .train_i        ( dcache_train_i         ),
+      .prefetch_o     ( dcache_prefetch_o      ),
+      .prefetch_hit_o ( dcache_prefetch_hit_o  ),
+      .axi_bypass_o   ( axi_req_bypass         ),
+      .axi_bypass_i   ( axi_resp_bypass        ),
+      .axi_data_o     ( axi_req_data           ),
+      .axi_data_i     ( axi_resp_data          ),
+      .req_ports_i    ( dcache_req_ports_i     ),
+      .req_ports_o    ( dcache_req_ports_o     ),
       .amo_req_i,
       .amo_resp_o
    );
@@ -257,11 +265,11 @@ module std_cache_subsystem #(
         icache_dreq_o.vaddr, icache_dreq_o.data);
 
   a_invalid_write_data: assert property (
-    @(posedge clk_i) disable iff (~rst_ni) dcache_req_ports_i[2].data_req |-> |dcache_req_ports_i[2].data_be |-> (|dcache_req_ports_i[2].data_wdata) !== 1'hX)
+    @(posedge clk_i) disable iff (~rst_ni) dcache_req_ports_i[NR_DCACHE_PORTS-1].data_req |-> |dcache_req_ports_i[NR_DCACHE_PORTS-1].data_be |-> (|dcache_req_ports_i[NR_DCACHE_PORTS-1].data_wdata) !== 1'hX)
       else $warning(1,"[l1 dcache] writing invalid data: paddr=%016X, be=%02X, data=%016X",
-        {dcache_req_ports_i[2].address_tag, dcache_req_ports_i[2].address_index}, dcache_req_ports_i[2].data_be, dcache_req_ports_i[2].data_wdata);
+        {dcache_req_ports_i[NR_DCACHE_PORTS-1].address_tag, dcache_req_ports_i[NR_DCACHE_PORTS-1].address_index}, dcache_req_ports_i[NR_DCACHE_PORTS-1].data_be, dcache_req_ports_i[NR_DCACHE_PORTS-1].data_wdata);
   generate
-      for(genvar j=0; j<2; j++) begin
+      for(genvar j=0; j<NR_DCACHE_PORTS-1; j++) begin
         a_invalid_read_data: assert property (
           @(posedge clk_i) disable iff (~rst_ni) dcache_req_ports_o[j].data_rvalid |-> (|dcache_req_ports_o[j].data_rdata) !== 1'hX)
             else $warning(1,"[l1 dcache] reading invalid data on port %01d: data=%016X",
@@ -16,7 +16,9 @@
 import ariane_pkg::*;
 import std_cache_pkg::*;
 
-module std_icache (
+module std_icache #(
+    parameter logic [63:0] CACHE_START_ADDR = 64'h8000_0000
+)(
     input  logic                     clk_i,
     input  logic                     rst_ni,
     input riscv::priv_lvl_t          priv_lvl_i,
@@ -41,7 +43,8 @@ module std_icache (
     // registers
     enum logic [3:0] { FLUSH, IDLE, TAG_CMP, WAIT_AXI_R_RESP, WAIT_KILLED_REFILL, WAIT_KILLED_AXI_R_RESP,
                        REDO_REQ, TAG_CMP_SAVED, REFILL,
-                       WAIT_ADDRESS_TRANSLATION, WAIT_ADDRESS_TRANSLATION_KILLED
+                       WAIT_ADDRESS_TRANSLATION, WAIT_ADDRESS_TRANSLATION_KILLED,
+                       WAIT_PREFETCH, PREFETCH_FILL
                      }                      state_d, state_q;
     logic [$clog2(ICACHE_NUM_WORD)-1:0]     cnt_d, cnt_q;
     logic [NR_AXI_REFILLS-1:0]              burst_cnt_d, burst_cnt_q; // counter for AXI transfers
@@ -49,6 +52,34 @@ module std_icache (
     logic [ICACHE_TAG_WIDTH-1:0]            tag_d, tag_q;
     logic [ICACHE_SET_ASSOC-1:0]            evict_way_d, evict_way_q;
     logic                                   flushing_d, flushing_q;
+    logic                                   restart_d, restart_q;     // the fetch which missed is served from the refill
+
+    // ------------------
+    // Next Line Prefetch
+    // ------------------
+    // a miss starts a stream of sequential lines which are prefetched into
+    // a small buffer while the frontend is busy with the current line, a
+    // later miss on one of them is served from the buffer in a single cycle
+    // instead of going to memory. the stream stops at the end of the page as
+    // we only have the translation of the current one.
+    localparam int unsigned PF_LINES        = (ICACHE_PREFETCH_LINES > 0) ? ICACHE_PREFETCH_LINES : 1;
+    localparam int unsigned PF_SLOT_BITS    = (PF_LINES > 1) ? $clog2(PF_LINES) : 1;
+    localparam int unsigned LINE_ADDR_WIDTH = ICACHE_TAG_WIDTH + ICACHE_INDEX_WIDTH - ICACHE_BYTE_OFFSET;
+    localparam int unsigned PAGE_LINE_BITS  = 12 - ICACHE_BYTE_OFFSET; // lines within a 4 KiB page
+
+    enum logic [1:0] { PF_IDLE, PF_AR, PF_R } pf_state_d, pf_state_q;
+
+    struct packed {
+        logic                                 valid;
+        logic [LINE_ADDR_WIDTH-1:0]           addr;
+        logic [(2**NR_AXI_REFILLS-1):0][63:0] data;
+    } pf_buf_d [PF_LINES-1:0], pf_buf_q [PF_LINES-1:0];
+
+    logic [LINE_ADDR_WIDTH-1:0]             pf_next_d, pf_next_q;       // next line of the stream, in flight in PF_AR and PF_R
+    logic                                   pf_active_d, pf_active_q;   // the stream has not reached the end of the page
+    logic                                   pf_stale_d, pf_stale_q;     // drop the line in flight, the buffer has been flushed
+    logic [PF_SLOT_BITS-1:0]                pf_slot_d, pf_slot_q;       // slot the line in flight goes to
+    logic [NR_AXI_REFILLS-1:0]              pf_burst_cnt_d, pf_burst_cnt_q;
 
     // signals
     logic [ICACHE_SET_ASSOC-1:0]          req;           // request to data memory
@@ -65,6 +96,18 @@ module std_icache (
     logic [$clog2(ICACHE_SET_ASSOC)-1:0]  repl_invalid;  // first non-valid encountered
     logic                                 repl_w_random; // we need to switch repl strategy since all are valid
     logic [ICACHE_TAG_WIDTH-1:0]          tag;           // tag to do comparison with
+    logic [LINE_ADDR_WIDTH-1:0]           pf_line;       // line of the current request
+    logic                                 pf_hit;        // the stream buffer holds the line
+    logic [PF_SLOT_BITS-1:0]              pf_hit_slot;
+    logic                                 pf_pending;    // the line is being prefetched
+    logic                                 pf_free;       // there is an empty slot in the stream buffer
+    logic [PF_SLOT_BITS-1:0]              pf_free_slot;
+    logic                                 pf_consume;    // line has been moved from the stream buffer into the cache
+    logic                                 pf_restart;    // demand refill, restart the stream after this line
+    logic [NR_AXI_REFILLS-1:0]            cw_beat;       // beat of the line which contains the fetch
+    logic [NR_AXI_REFILLS-1:0]            refill_beat;   // beat of the line the refill is returning
+    logic                                 cw_forward;    // hand the critical word to the frontend
+    logic                                 refill_cwf;    // refill the line critical word first
 
     // tag + valid bit read/write data
     struct packed {
@@ -133,6 +176,9 @@ module std_icache (
         dreq_o.data = cl_sel[0];
         for(int i = 1; i < ICACHE_SET_ASSOC; i++)
             dreq_o.data |= cl_sel[i];
+        // early restart, the fetch gets its word straight from the bus
+        if (cw_forward)
+            dreq_o.data = axi_resp_i.r.data[{vaddr_q[2], 5'b0} +: FETCH_WIDTH];
     end
 
     // ------------------
@@ -162,7 +208,6 @@ module std_icache (
     assign axi_req_o.ar.region = '0;
     assign axi_req_o.ar.len    = (2**NR_AXI_REFILLS) - 1;
     assign axi_req_o.ar.size   = 3'b011;
-    assign axi_req_o.ar.burst  = 2'b01;
     assign axi_req_o.ar.lock   = '0;
     assign axi_req_o.ar.cache  = '0;
     assign axi_req_o.ar.qos    = '0;
@@ -173,10 +218,18 @@ module std_icache (
     assign data_be = be;
     assign data_wdata = wdata;
 
-    assign dreq_o.ex = areq_i.fetch_exception;
+    // the critical word is only forwarded for fetches without an exception
+    assign dreq_o.ex = cw_forward ? '0 : areq_i.fetch_exception;
 
     assign addr = (state_q==FLUSH) ? cnt_q : vaddr_d[ICACHE_INDEX_WIDTH-1:ICACHE_BYTE_OFFSET];
 
+    // only main memory gets wrapping bursts, the boot ROM and the debug module are refilled
+    // from the beginning of the line, a critical word first refill starts with the beat the
+    // fetch is waiting for
+    assign refill_cwf  = REFILL_CRITICAL_WORD_FIRST && (tag_q >= CACHE_START_ADDR[ICACHE_TAG_WIDTH+ICACHE_INDEX_WIDTH-1:ICACHE_INDEX_WIDTH]);
+    assign cw_beat     = vaddr_q[3 +: NR_AXI_REFILLS];
+    assign refill_beat = refill_cwf ? cw_beat + burst_cnt_q : burst_cnt_q;
+
     // ------------------
     // Cache Ctrl
     // ------------------
@@ -191,6 +244,7 @@ module std_icache (
         evict_way_d  = evict_way_q;
         flushing_d   = flushing_q;
         burst_cnt_d  = burst_cnt_q;
+        restart_d    = restart_q;
 
         dreq_o.vaddr = vaddr_q;
 
@@ -208,6 +262,11 @@ module std_icache (
 
         axi_req_o.ar_valid = 1'b0;
         axi_req_o.ar.addr  = '0;
+        axi_req_o.ar.burst = 2'b01;
+
+        pf_consume   = 1'b0;
+        pf_restart   = 1'b0;
+        cw_forward   = 1'b0;
 
         areq_o.fetch_req = 1'b0;
         areq_o.fetch_vaddr = vaddr_q;
@@ -275,6 +334,8 @@ module std_icache (
                     // save tag
                     tag_d       = areq_i.fetch_paddr[ICACHE_TAG_WIDTH+ICACHE_INDEX_WIDTH-1:ICACHE_INDEX_WIDTH];
                     miss_o      = en_i;
+                    // the refill can serve the fetch directly if it did not raise an exception
+                    restart_d   = !areq_i.fetch_exception.valid;
                     // get way which to replace
                     // only if there is no hit we should fall back to real replacement. If there was a hit then
                     // it means we are in bypass mode (!en_i) and should update the cache-line with the most recent
@@ -290,6 +351,13 @@ module std_icache (
                             evict_way_d[repl_invalid] = 1'b1;
                         end
                     end
+                    // the line might already be in the stream buffer or on its way
+                    if (en_i && !areq_i.fetch_exception.valid) begin
+                        if (pf_hit)
+                            state_d = PREFETCH_FILL;
+                        else if (pf_pending)
+                            state_d = WAIT_PREFETCH;
+                    end
                 end
                 // if we didn't hit on the TLB we need to wait until the request has been completed
                 if (!areq_i.fetch_valid) begin
@@ -317,16 +385,48 @@ module std_icache (
             end
             // ~> request a cache-line refill
             REFILL, WAIT_KILLED_REFILL: begin
-                axi_req_o.ar_valid  = 1'b1;
+                // a prefetch which is already on the bus needs to finish first
+                axi_req_o.ar_valid  = (pf_state_q == PF_IDLE);
                 axi_req_o.ar.addr[ICACHE_INDEX_WIDTH+ICACHE_TAG_WIDTH-1:0] = {tag_q, vaddr_q[ICACHE_INDEX_WIDTH-1:ICACHE_BYTE_OFFSET], {ICACHE_BYTE_OFFSET{1'b0}}};
+                // start with the word the fetch is waiting for and wrap around the line
+                if (refill_cwf) begin
+                    axi_req_o.ar.addr[3 +: NR_AXI_REFILLS] = cw_beat;
+                    axi_req_o.ar.burst = 2'b10;
+                end
                 burst_cnt_d = '0;
 
                 if (dreq_i.kill_s2)
                     state_d = WAIT_KILLED_REFILL;
 
                 // we need to finish this AXI transfer
-                if (axi_resp_i.ar_ready)
+                if (axi_req_o.ar_valid && axi_resp_i.ar_ready) begin
                     state_d = (dreq_i.kill_s2 || (state_q == WAIT_KILLED_REFILL)) ? WAIT_KILLED_AXI_R_RESP : WAIT_AXI_R_RESP;
+                    pf_restart = en_i;
+                end
+            end
+            // ~> the missing line is being prefetched, wait for it
+            WAIT_PREFETCH: begin
+                if (pf_hit)
+                    state_d = PREFETCH_FILL;
+                else if (!pf_pending)
+                    state_d = REFILL;
+            end
+            // ~> move the line from the stream buffer into the cache
+            PREFETCH_FILL: begin
+                if (pf_hit) begin
+                    req             = evict_way_q;
+                    vld_req         = evict_way_q;
+                    we              = 1'b1;
+                    be              = '1;
+                    tag_wdata.tag   = tag_q;
+                    tag_wdata.valid = 1'b1;
+                    wdata           = pf_buf_q[pf_hit_slot].data;
+                    pf_consume      = 1'b1;
+                    state_d         = REDO_REQ;
+                // the stream buffer has been flushed in the meantime
+                end else begin
+                    state_d         = REFILL;
+                end
             end
             // ~> wait for the read response
             WAIT_AXI_R_RESP, WAIT_KILLED_AXI_R_RESP: begin
@@ -338,18 +438,24 @@ module std_icache (
                     we = 1'b1;
                     tag_wdata.tag = tag_q;
                     tag_wdata.valid = 1'b1;
-                    wdata[burst_cnt_q] = axi_resp_i.r.data;
+                    wdata[refill_beat] = axi_resp_i.r.data;
                     // enable the right write path
-                    be[burst_cnt_q] = '1;
+                    be[refill_beat] = '1;
                     // increase burst count
                     burst_cnt_d = burst_cnt_q + 1;
+                    // early restart: the fetch does not need to wait for the rest of the line
+                    if (state_q == WAIT_AXI_R_RESP && restart_q && refill_beat == cw_beat) begin
+                        dreq_o.valid = 1'b1;
+                        cw_forward   = 1'b1;
+                    end
                 end
 
                 if (dreq_i.kill_s2)
                     state_d = WAIT_KILLED_AXI_R_RESP;
 
+                // the fetch has already been served if we restarted early
                 if (axi_resp_i.r_valid && axi_resp_i.r.last) begin
-                    state_d = (dreq_i.kill_s2) ? IDLE : REDO_REQ;
+                    state_d = (dreq_i.kill_s2 || restart_q) ? IDLE : REDO_REQ;
                 end
 
                 if ((state_q == WAIT_KILLED_AXI_R_RESP) && axi_resp_i.r.last && axi_resp_i.r_valid)
@@ -377,6 +483,14 @@ module std_icache (
             default : state_d = IDLE;
         endcase
 
+        // the prefetcher only gets the bus while there is no refill going on, prefetched
+        // lines always come with an incrementing burst from the beginning of the line
+        if (pf_state_q == PF_AR) begin
+            axi_req_o.ar_valid = 1'b1;
+            axi_req_o.ar.addr[ICACHE_INDEX_WIDTH+ICACHE_TAG_WIDTH-1:0] = {pf_next_q, {ICACHE_BYTE_OFFSET{1'b0}}};
+            axi_req_o.ar.burst = 2'b01;
+        end
+
         // those are the states where we need to wait a little longer until we can safely exit
         if (dreq_i.kill_s2 && !(state_q inside {
                                                     REFILL,
@@ -402,6 +516,97 @@ module std_icache (
             dreq_o.ready = 1'b0;
     end
 
+    // ------------------
+    // Prefetch Ctrl
+    // ------------------
+    assign pf_line = {(state_q inside {TAG_CMP, TAG_CMP_SAVED}) ? areq_i.fetch_paddr[ICACHE_TAG_WIDTH+ICACHE_INDEX_WIDTH-1:ICACHE_INDEX_WIDTH] : tag_q,
+                      vaddr_q[ICACHE_INDEX_WIDTH-1:ICACHE_BYTE_OFFSET]};
+
+    assign pf_pending = (pf_state_q != PF_IDLE) && !pf_stale_q && (pf_next_q == pf_line);
+
+    always_comb begin : stream_buffer_lookup
+        pf_hit       = 1'b0;
+        pf_hit_slot  = '0;
+        pf_free      = 1'b0;
+        pf_free_slot = '0;
+
+        for (int unsigned i = 0; i < PF_LINES; i++) begin
+            if (pf_buf_q[i].valid && pf_buf_q[i].addr == pf_line) begin
+                pf_hit      = 1'b1;
+                pf_hit_slot = i[PF_SLOT_BITS-1:0];
+            end
+            if (!pf_buf_q[i].valid) begin
+                pf_free      = 1'b1;
+                pf_free_slot = i[PF_SLOT_BITS-1:0];
+            end
+        end
+    end
+
+    always_comb begin : prefetch_ctrl
+        pf_state_d     = pf_state_q;
+        pf_buf_d       = pf_buf_q;
+        pf_next_d      = pf_next_q;
+        pf_active_d    = pf_active_q;
+        pf_stale_d     = pf_stale_q;
+        pf_slot_d      = pf_slot_q;
+        pf_burst_cnt_d = pf_burst_cnt_q;
+
+        if (pf_consume)
+            pf_buf_d[pf_hit_slot].valid = 1'b0;
+
+        case (pf_state_q)
+            // ~> fetch the next line of the stream as soon as there is space and the bus is free
+            PF_IDLE: begin
+                if (pf_active_q && pf_free && en_i && !flush_i && !flushing_q &&
+                    !(state_q inside {FLUSH, REFILL, WAIT_KILLED_REFILL, WAIT_AXI_R_RESP, WAIT_KILLED_AXI_R_RESP})) begin
+                    pf_state_d = PF_AR;
+                    pf_slot_d  = pf_free_slot;
+                    pf_stale_d = 1'b0;
+                end
+            end
+            PF_AR: begin
+                pf_burst_cnt_d = '0;
+                if (axi_resp_i.ar_ready)
+                    pf_state_d = PF_R;
+            end
+            PF_R: begin
+                if (axi_resp_i.r_valid) begin
+                    pf_buf_d[pf_slot_q].data[pf_burst_cnt_q] = axi_resp_i.r.data;
+                    pf_burst_cnt_d = pf_burst_cnt_q + 1;
+
+                    if (axi_resp_i.r.last) begin
+                        pf_state_d = PF_IDLE;
+                        if (!pf_stale_q) begin
+                            pf_buf_d[pf_slot_q].valid = 1'b1;
+                            pf_buf_d[pf_slot_q].addr  = pf_next_q;
+                            pf_next_d                 = pf_next_q + 1;
+                            // that was the last line of the page
+                            if (&pf_next_q[PAGE_LINE_BITS-1:0])
+                                pf_active_d = 1'b0;
+                        end
+                    end
+                end
+            end
+            default: pf_state_d = PF_IDLE;
+        endcase
+
+        // a demand refill has been sent, the stream continues after the missing line
+        if (pf_restart) begin
+            for (int unsigned i = 0; i < PF_LINES; i++)
+                pf_buf_d[i].valid = 1'b0;
+            pf_next_d   = pf_line + 1;
+            pf_active_d = (ICACHE_PREFETCH_LINES > 0) && !(&pf_line[PAGE_LINE_BITS-1:0]);
+        end
+
+        // the instruction memory might have changed (fence.i)
+        if (flush_i) begin
+            for (int unsigned i = 0; i < PF_LINES; i++)
+                pf_buf_d[i].valid = 1'b0;
+            pf_active_d = 1'b0;
+            pf_stale_d  = (pf_state_q != PF_IDLE);
+        end
+    end
+
     lzc #(
         .WIDTH ( ICACHE_SET_ASSOC )
     ) i_lzc (
@@ -429,7 +634,16 @@ module std_icache (
             tag_q       <= '0;
             evict_way_q <= '0;
             flushing_q  <= 1'b0;
+            restart_q   <= 1'b0;
             burst_cnt_q <= '0;;
+            pf_state_q     <= PF_IDLE;
+            pf_next_q      <= '0;
+            pf_active_q    <= 1'b0;
+            pf_stale_q     <= 1'b0;
+            pf_slot_q      <= '0;
+            pf_burst_cnt_q <= '0;
+            for (int unsigned i = 0; i < PF_LINES; i++)
+                pf_buf_q[i] <= '0;
         end else begin
             state_q     <= state_d;
             cnt_q       <= cnt_d;
@@ -437,7 +651,15 @@ module std_icache (
             tag_q       <= tag_d;
             evict_way_q <= evict_way_d;
             flushing_q  <= flushing_d;
+            restart_q   <= restart_d;
             burst_cnt_q <= burst_cnt_d;
+            pf_state_q     <= pf_state_d;
+            pf_next_q      <= pf_next_d;
+            pf_active_q    <= pf_active_d;
+            pf_stale_q     <= pf_stale_d;
+            pf_slot_q      <= pf_slot_d;
+            pf_burst_cnt_q <= pf_burst_cnt_d;
+            pf_buf_q       <= pf_buf_d;
         end
     end
 
@@ -452,6 +674,12 @@ initial begin
         else $fatal(1, "[icache] Ariane needs a 64-bit bus");
 end
 
+// the prefetcher and the refill never share the bus
+pf_refill_exclusive: assert property (
+    @(posedge clk_i) disable iff (~rst_ni)
+        (state_q inside {WAIT_AXI_R_RESP, WAIT_KILLED_AXI_R_RESP}) |-> (pf_state_q == PF_IDLE))
+        else $fatal(1, "[icache] prefetch and refill in flight at the same time");
+
 // assert that cache only hits on one way
 onehot: assert property (
     @(posedge clk_i) disable iff (~rst_ni) $onehot0(hit))
@@ -25,12 +25,16 @@ module std_nbdcache #(
     input  logic                           flush_i,     // high until acknowledged
     output logic                           flush_ack_o, // send a single cycle acknowledge signal when the cache is flushed
     output logic                           miss_o,      // we missed on a LD/ST
+    // Prefetcher
+    input  dcache_train_t                  train_i,          // loads which have been sent to the cache
+    output logic                           prefetch_o,       // a line is prefetched
+    output logic                           prefetch_hit_o,   // a load accessed a prefetched line
     // AMOs
     input  amo_req_t                       amo_req_i,
     output amo_resp_t                      amo_resp_o,
     // Request ports
-    input  dcache_req_i_t [2:0]            req_ports_i,  // request ports
-    output dcache_req_o_t [2:0]            req_ports_o,  // request ports
+    input  dcache_req_i_t [NR_DCACHE_PORTS-1:0] req_ports_i,  // request ports
+    output dcache_req_o_t [NR_DCACHE_PORTS-1:0] req_ports_o,  // request ports
     // Cache AXI refill port
     output ariane_axi::req_t               axi_data_o,
     input  ariane_axi::resp_t              axi_data_i,
@@ -43,35 +47,42 @@ module std_nbdcache #(
     // -------------------------------
     // 1. Miss handler
     // 2. PTW
-    // 3. Load Unit
+    // 3. Load Unit (NR_LOAD_PORTS)
     // 4. Store unit
-    logic        [3:0][DCACHE_SET_ASSOC-1:0]  req;
-    logic        [3:0][DCACHE_INDEX_WIDTH-1:0]addr;
-    logic        [3:0]                        gnt;
-    cache_line_t [DCACHE_SET_ASSOC-1:0]       rdata;
-    logic        [3:0][DCACHE_TAG_WIDTH-1:0]  tag;
+    logic        [NR_DCACHE_PORTS:0][DCACHE_SET_ASSOC-1:0]   req;
+    logic        [NR_DCACHE_PORTS:0][DCACHE_INDEX_WIDTH-1:0] addr;
+    logic        [NR_DCACHE_PORTS:0]                         gnt;
+    cache_line_t [DCACHE_SET_ASSOC-1:0]                      rdata;
+    logic        [NR_DCACHE_PORTS:0][DCACHE_TAG_WIDTH-1:0]   tag;
 
-    cache_line_t [3:0]                        wdata;
-    logic        [3:0]                        we;
-    cl_be_t      [3:0]                        be;
+    cache_line_t [NR_DCACHE_PORTS:0]                         wdata;
+    logic        [NR_DCACHE_PORTS:0]                         we;
+    cl_be_t      [NR_DCACHE_PORTS:0]                         be;
     logic        [DCACHE_SET_ASSOC-1:0]       hit_way;
     // -------------------------------
     // Controller <-> Miss unit
     // -------------------------------
-    logic [2:0]                        busy;
-    logic [2:0][55:0]                  mshr_addr;
-    logic [2:0]                        mshr_addr_matches;
-    logic [2:0]                        mshr_index_matches;
-    logic [63:0]                       critical_word;
-    logic                              critical_word_valid;
+    logic [NR_DCACHE_PORTS-1:0]                        busy;
+    logic [NR_DCACHE_PORTS-1:0][55:0]                  mshr_addr;
+    logic [NR_DCACHE_PORTS-1:0]                        mshr_addr_matches;
+    logic [NR_DCACHE_PORTS-1:0]                        mshr_index_matches;
+    logic [63:0]                                       critical_word;
+    logic                                              critical_word_valid;
 
-    logic [2:0][$bits(miss_req_t)-1:0] miss_req;
-    logic [2:0]                        miss_gnt;
-    logic [2:0]                        active_serving;
+    logic [NR_DCACHE_PORTS-1:0][$bits(miss_req_t)-1:0] miss_req;
+    logic [NR_DCACHE_PORTS-1:0]                        miss_gnt;
+    logic [NR_DCACHE_PORTS-1:0]                        active_serving;
 
-    logic [2:0]                        bypass_gnt;
-    logic [2:0]                        bypass_valid;
-    logic [2:0][63:0]                  bypass_data;
+    logic [NR_DCACHE_PORTS-1:0]                        bypass_gnt;
+    logic [NR_DCACHE_PORTS-1:0]                        bypass_valid;
+    logic [NR_DCACHE_PORTS-1:0][63:0]                  bypass_data;
+    // -------------------------------
+    // Prefetcher <-> Miss unit
+    // -------------------------------
+    logic                                              prefetch_req;
+    logic [55:0]                                       prefetch_addr;
+    logic                                              prefetch_gnt;
+    logic [55:0]                                       prefetch_refill_addr;
     // -------------------------------
     // Arbiter <-> Datram,
     // -------------------------------
@@ -86,7 +97,7 @@ module std_nbdcache #(
     // Cache Controller
     // ------------------
     generate
-        for (genvar i = 0; i < 3; i++) begin : master_ports
+        for (genvar i = 0; i < NR_DCACHE_PORTS; i++) begin : master_ports
             cache_ctrl  #(
                 .CACHE_START_ADDR      ( CACHE_START_ADDR     )
             ) i_cache_ctrl (
@@ -127,7 +138,7 @@ module std_nbdcache #(
     // Miss Handling Unit
     // ------------------
     miss_handler #(
-        .NR_PORTS               ( 3                    )
+        .NR_PORTS               ( NR_DCACHE_PORTS      )
     ) i_miss_handler (
         .flush_i                ( flush_i              ),
         .busy_i                 ( |busy                ),
@@ -141,6 +152,11 @@ module std_nbdcache #(
         .bypass_data_o          ( bypass_data          ),
         .critical_word_o        ( critical_word        ),
         .critical_word_valid_o  ( critical_word_valid  ),
+        .prefetch_req_i         ( prefetch_req & enable_i ), // do not fill a disabled cache
+        .prefetch_addr_i        ( prefetch_addr        ),
+        .prefetch_gnt_o         ( prefetch_gnt         ),
+        .prefetch_refill_o      ( prefetch_o           ),
+        .prefetch_refill_addr_o ( prefetch_refill_addr ),
         .mshr_addr_i            ( mshr_addr            ),
         .mshr_addr_matches_o    ( mshr_addr_matches    ),
         .mshr_index_matches_o   ( mshr_index_matches   ),
@@ -160,6 +176,32 @@ module std_nbdcache #(
 
     assign tag[0] = '0;
 
+    // ------------------
+    // Prefetcher
+    // ------------------
+    generate
+        if (DCACHE_PREFETCH_ENTRIES > 0) begin : gen_prefetcher
+            stride_prefetcher #(
+                .NR_ENTRIES       ( DCACHE_PREFETCH_ENTRIES ),
+                .CACHE_START_ADDR ( CACHE_START_ADDR        )
+            ) i_stride_prefetcher (
+                .clk_i,
+                .rst_ni,
+                .train_i          ( train_i                 ),
+                .prefetch_req_o   ( prefetch_req            ),
+                .prefetch_addr_o  ( prefetch_addr           ),
+                .prefetch_gnt_i   ( prefetch_gnt            ),
+                .refill_i         ( prefetch_o              ),
+                .refill_addr_i    ( prefetch_refill_addr    ),
+                .prefetch_hit_o   ( prefetch_hit_o          )
+            );
+        end else begin : gen_no_prefetcher
+            assign prefetch_req   = 1'b0;
+            assign prefetch_addr  = '0;
+            assign prefetch_hit_o = 1'b0;
+        end
+    endgenerate
+
     // --------------
     // Memory Arrays
     // --------------
@@ -228,7 +270,7 @@ module std_nbdcache #(
     // Tag Comparison and memory arbitration
     // ------------------------------------------------
     tag_cmp #(
-        .NR_PORTS           ( 4                  ),
+        .NR_PORTS           ( NR_DCACHE_PORTS+1  ),
         .ADDR_WIDTH         ( DCACHE_INDEX_WIDTH ),
         .DCACHE_SET_ASSOC   ( DCACHE_SET_ASSOC   )
     ) i_tag_cmp (
@@ -0,0 +1,179 @@
+// Copyright 2018 ETH Zurich and University of Bologna.
+// Copyright and related rights are licensed under the Solderpad Hardware
+// License, Version 0.51 (the "License"); you may not use this file except in
+// compliance with the License.  You may obtain a copy of the License at
+// http://solderpad.org/licenses/SHL-0.51. Unless required by applicable law
+// or agreed to in writing, software, hardware and materials distributed under
+// this License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+//
+// Description: Stride prefetcher for the D$ - reference prediction table
+//              indexed by the PC of the load
+
+// Every load which sends its tag to the cache trains the table with its PC and
+// physical address. Once a stride has been confirmed by two more loads the line
+// 2**LOOKAHEAD strides ahead of the load is handed to the miss handler, which
+// refills it when it has nothing else to do. Small strides stay in the same
+// line for a couple of loads, a prefetch is only made when the target moves to
+// a new line. As the addresses are physical the prefetcher never crosses a page.
+//
+// The last NR_TRACK refilled lines are remembered, a load to one of them
+// counts as a useful prefetch (prefetch_hit_o).
+import ariane_pkg::*;
+import std_cache_pkg::*;
+
+module stride_prefetcher #(
+    parameter int unsigned NR_ENTRIES       = 16,
+    parameter int unsigned TAG_BITS         = 8,
+    parameter int unsigned LOOKAHEAD        = 4,
+    parameter int unsigned NR_TRACK         = 8,
+    parameter logic [63:0] CACHE_START_ADDR = 64'h8000_0000
+)(
+    input  logic                  clk_i,
+    input  logic                  rst_ni,
+    // loads from the load unit
+    input  dcache_train_t         train_i,
+    // to the miss handler
+    output logic                  prefetch_req_o,
+    output logic [55:0]           prefetch_addr_o,
+    input  logic                  prefetch_gnt_i,
+    // the miss handler refills a prefetched line
+    input  logic                  refill_i,
+    input  logic [55:0]           refill_addr_i,
+    // performance counter
+    output logic                  prefetch_hit_o   // a load accessed a prefetched line
+);
+    localparam OFFSET    = 1; // we are using compressed instructions so do use the lower bit for the index
+    localparam TRACK_PTR = (NR_TRACK > 1) ? $clog2(NR_TRACK) : 1;
+
+    struct packed {
+        logic                valid;
+        logic [TAG_BITS-1:0] tag;
+        logic [55:0]         last_addr;
+        logic [12:0]         stride;     // within a page
+        logic [1:0]          confidence;
+    } rpt_d [NR_ENTRIES-1:0], rpt_q [NR_ENTRIES-1:0];
+
+    struct packed {
+        logic                               valid;
+        logic [55-DCACHE_BYTE_OFFSET:0]     line;
+    } track_d [NR_TRACK-1:0], track_q [NR_TRACK-1:0];
+
+    logic [TRACK_PTR-1:0]          track_ptr_d, track_ptr_q;
+    // the training input is registered to keep the prefetcher off the load path
+    dcache_train_t                 train_q;
+    logic [$clog2(NR_ENTRIES)-1:0] index;
+    logic [TAG_BITS-1:0]           tag;
+    // next prefetch, waits for the miss handler
+    logic                          req_d, req_q;
+    logic [55:0]                   addr_d, addr_q;
+
+    assign index = train_q.pc[OFFSET +: $clog2(NR_ENTRIES)];
+    assign tag   = train_q.pc[OFFSET + $clog2(NR_ENTRIES) +: TAG_BITS];
+
+    assign prefetch_req_o  = req_q;
+    assign prefetch_addr_o = addr_q;
+
+    always_comb begin : update_rpt
+        automatic logic [55:0] delta, target, prev_target;
+        automatic logic        match;
+
+        rpt_d  = rpt_q;
+        req_d  = req_q && !prefetch_gnt_i;
+        addr_d = addr_q;
+
+        delta       = train_q.paddr - rpt_q[index].last_addr;
+        match       = rpt_q[index].valid && rpt_q[index].tag == tag;
+        target      = '0;
+        prev_target = '0;
+
+        if (train_q.valid) begin
+            // a new load, start with an unknown stride
+            if (!match) begin
+                rpt_d[index].valid      = 1'b1;
+                rpt_d[index].tag        = tag;
+                rpt_d[index].last_addr  = train_q.paddr;
+                rpt_d[index].stride     = '0;
+                rpt_d[index].confidence = '0;
+            end else begin
+                rpt_d[index].last_addr = train_q.paddr;
+                // the physical address of the next page says nothing about the stride, keep the entry
+                if (train_q.paddr[55:12] == rpt_q[index].last_addr[55:12]) begin
+                    if (delta[12:0] == rpt_q[index].stride) begin
+                        if (rpt_q[index].confidence != 2'b11)
+                            rpt_d[index].confidence = rpt_q[index].confidence + 1;
+                    end else begin
+                        if (rpt_q[index].confidence != 2'b00)
+                            rpt_d[index].confidence = rpt_q[index].confidence - 1;
+                        // only replace a stride we were not sure about
+                        if (rpt_q[index].confidence < 2'b10)
+                            rpt_d[index].stride = delta[12:0];
+                    end
+                end
+            end
+
+            // the stride is confirmed
+            if (match && rpt_d[index].confidence >= 2'b10 && rpt_d[index].stride != '0) begin
+                target      = train_q.paddr + ({{43{rpt_d[index].stride[12]}}, rpt_d[index].stride} << LOOKAHEAD);
+                prev_target = target - {{43{rpt_d[index].stride[12]}}, rpt_d[index].stride};
+                // stay in the page and in the cached region, only prefetch each line once
+                if (target[55:12] == train_q.paddr[55:12]
+                    && {8'b0, train_q.paddr} >= CACHE_START_ADDR
+                    && target[55:DCACHE_BYTE_OFFSET] != prev_target[55:DCACHE_BYTE_OFFSET]) begin
+                    req_d  = 1'b1;
+                    addr_d = {target[55:DCACHE_BYTE_OFFSET], {{DCACHE_BYTE_OFFSET}{1'b0}}};
+                end
+            end
+        end
+    end
+
+    always_comb begin : track_refills
+        track_d        = track_q;
+        track_ptr_d    = track_ptr_q;
+        prefetch_hit_o = 1'b0;
+
+        // a load to a line we have prefetched, only count the first one
+        for (int unsigned i = 0; i < NR_TRACK; i++) begin
+            if (train_q.valid && track_q[i].valid && track_q[i].line == train_q.paddr[55:DCACHE_BYTE_OFFSET]) begin
+                prefetch_hit_o   = 1'b1;
+                track_d[i].valid = 1'b0;
+            end
+        end
+
+        if (refill_i) begin
+            track_d[track_ptr_q].valid = 1'b1;
+            track_d[track_ptr_q].line  = refill_addr_i[55:DCACHE_BYTE_OFFSET];
+            track_ptr_d = (track_ptr_q == NR_TRACK-1) ? '0 : track_ptr_q + 1;
+        end
+    end
+
+    always_ff @(posedge clk_i or negedge rst_ni) begin
+        if (~rst_ni) begin
+            train_q     <= '0;
+            req_q       <= 1'b0;
+            addr_q      <= '0;
+            track_ptr_q <= '0;
+            for (int unsigned i = 0; i < NR_ENTRIES; i++)
+                rpt_q[i] <= '0;
+            for (int unsigned i = 0; i < NR_TRACK; i++)
+                track_q[i] <= '0;
+        end else begin
+            train_q     <= train_i;
+            req_q       <= req_d;
+            addr_q      <= addr_d;
+            track_ptr_q <= track_ptr_d;
+            rpt_q       <= rpt_d;
+            track_q     <= track_d;
+        end
+    end
+
+//pragma translate_off
+`ifndef VERILATOR
+    initial begin
+        assert (2**$clog2(NR_ENTRIES) == NR_ENTRIES)
+            else $fatal(1, "[stride_prefetcher] the number of entries has to be a power of two");
+    end
+`endif
+//pragma translate_on
+endmodule
@@ -251,7 +251,19 @@ module csr_regfile #(
                 riscv::CSR_RET,
                 riscv::CSR_MIS_PREDICT,
                 riscv::CSR_SB_FULL,
-                riscv::CSR_IF_EMPTY:           csr_rdata   = perf_data_i;
+                riscv::CSR_IF_EMPTY,
+                riscv::CSR_BHT_MIS_PREDICT,
+                riscv::CSR_RAS_HIT,
+                riscv::CSR_RAS_MISS,
+                riscv::CSR_BTB_MIS_PREDICT,
+                riscv::CSR_SB_OCC_Q0,
+                riscv::CSR_SB_OCC_Q1,
+                riscv::CSR_SB_OCC_Q2,
+                riscv::CSR_SB_OCC_Q3,
+                riscv::CSR_LD_FORWARD,
+                riscv::CSR_LD_ST_STALL,
+                riscv::CSR_L1_DCACHE_PREFETCH,
+                riscv::CSR_L1_DCACHE_PREFETCH_HIT: csr_rdata   = perf_data_i;
                 default: read_access_exception = 1'b1;
             endcase
         end
@@ -519,7 +531,19 @@ module csr_regfile #(
                 riscv::CSR_BRANCH_JUMP,
                 riscv::CSR_CALL,
                 riscv::CSR_RET,
-                riscv::CSR_MIS_PREDICT: begin
+                riscv::CSR_MIS_PREDICT,
+                riscv::CSR_BHT_MIS_PREDICT,
+                riscv::CSR_RAS_HIT,
+                riscv::CSR_RAS_MISS,
+                riscv::CSR_BTB_MIS_PREDICT,
+                riscv::CSR_SB_OCC_Q0,
+                riscv::CSR_SB_OCC_Q1,
+                riscv::CSR_SB_OCC_Q2,
+                riscv::CSR_SB_OCC_Q3,
+                riscv::CSR_LD_FORWARD,
+                riscv::CSR_LD_ST_STALL,
+                riscv::CSR_L1_DCACHE_PREFETCH,
+                riscv::CSR_L1_DCACHE_PREFETCH_HIT: begin
                                         perf_data_o = csr_wdata;
                                         perf_we_o   = 1'b1;
                 end
@@ -15,7 +15,9 @@
 
 import ariane_pkg::*;
 
-module ex_stage (
+module ex_stage #(
+    parameter logic [63:0] CACHE_START_ADDR = 64'h8000_0000 // begin of cached region
+)(
     input  logic                                   clk_i,    // Clock
     input  logic                                   rst_ni,   // Asynchronous reset active low
     input  logic                                   flush_i,
@@ -33,6 +35,12 @@ module ex_stage (
     // Branches and Jumps
     // ALU 1
     input  logic                                   alu_valid_i,           // Output is valid
+    // ALU 2, second issue lane with its own write-back port
+    input  fu_data_t                               alu2_fu_data_i,
+    input  logic                                   alu2_valid_i,
+    output logic [63:0]                            alu2_result_o,
+    output logic [TRANS_ID_BITS-1:0]               alu2_trans_id_o,
+    output logic                                   alu2_valid_o,
     // Branch Unit
     input  logic                                   branch_valid_i,        // we are using the branch unit
     input  branchpredict_sbe_t                     branch_predict_i,
@@ -88,13 +96,16 @@ module ex_stage (
     output icache_areq_i_t                         icache_areq_o,
 
     // interface to dcache
-    input  dcache_req_o_t [2:0]                    dcache_req_ports_i,
-    output dcache_req_i_t [2:0]                    dcache_req_ports_o,
+    input  dcache_req_o_t [NR_DCACHE_PORTS-1:0]    dcache_req_ports_i,
+    output dcache_req_i_t [NR_DCACHE_PORTS-1:0]    dcache_req_ports_o,
     output amo_req_t                               amo_req_o,          // request to cache subsytem
     input  amo_resp_t                              amo_resp_i,         // response from cache subsystem
+    output dcache_train_t                          dcache_train_o,     // loads for the D$ prefetcher
     // Performance counters
     output logic                                   itlb_miss_o,
-    output logic                                   dtlb_miss_o
+    output logic                                   dtlb_miss_o,
+    output logic                                   ld_forward_o,         // load got data from the store buffer
+    output logic                                   ld_stall_o            // load waits for the store buffer to drain
 );
 
     // -------------------------
@@ -209,6 +220,33 @@ module ex_stage (
         .mult_trans_id_o ( mult_trans_id )
     );
 
+    // ----------------
+    // ALU 2
+    // ----------------
+    // integer ALU instructions of the second issue lane, single cycle and
+    // without exceptions
+    generate
+        if (ISSUE_WIDTH > 1) begin : alu2_gen
+            fu_data_t alu2_data;
+            assign alu2_data = alu2_valid_i ? alu2_fu_data_i : '0;
+
+            alu alu2_i (
+                .clk_i,
+                .rst_ni,
+                .fu_data_i        ( alu2_data     ),
+                .result_o         ( alu2_result_o ),
+                .alu_branch_res_o (               )
+            );
+
+            assign alu2_trans_id_o = alu2_fu_data_i.trans_id;
+            assign alu2_valid_o    = alu2_valid_i;
+        end else begin : no_alu2_gen
+            assign alu2_result_o   = '0;
+            assign alu2_trans_id_o = '0;
+            assign alu2_valid_o    = 1'b0;
+        end
+    endgenerate
+
     // ----------------
     // FPU
     // ----------------
@@ -249,12 +287,15 @@ module ex_stage (
 
     assign lsu_data  = lsu_valid_i ? fu_data_i  : '0;
 
-    load_store_unit lsu_i (
+    load_store_unit #(
+        .CACHE_START_ADDR ( CACHE_START_ADDR )
+    ) lsu_i (
         .clk_i,
         .rst_ni,
         .flush_i,
         .no_st_pending_o,
         .fu_data_i             ( lsu_data ),
+        .pc_i,
         .lsu_ready_o,
         .lsu_valid_i,
         .load_trans_id_o,
@@ -280,8 +321,11 @@ module ex_stage (
         .flush_tlb_i,
         .itlb_miss_o,
         .dtlb_miss_o,
+        .ld_forward_o,
+        .ld_stall_o,
         .dcache_req_ports_i,
         .dcache_req_ports_o,
+        .dcache_train_o,
         .amo_valid_commit_i,
         .amo_req_o,
         .amo_resp_i
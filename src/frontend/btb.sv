@@ -18,8 +18,14 @@
 // ------------------------------
 
 // branch target buffer
+// NR_WAYS way set-associative, every way keeps TAG_BITS of the PC above the
+// set index so that jumps which map to the same set do not alias. The ways of
+// a set are replaced in least recently used order, an access is an update from
+// the branch unit (every resolved indirect jump updates its entry).
 module btb #(
-    parameter int NR_ENTRIES = 8
+    parameter int NR_ENTRIES = 8,
+    parameter int NR_WAYS    = 2,
+    parameter int TAG_BITS   = 8
 )(
     input  logic                        clk_i,           // Clock
     input  logic                        rst_ni,          // Asynchronous reset active low
@@ -32,35 +38,82 @@ module btb #(
 );
     // number of bits which are not used for indexing
     localparam OFFSET = 1; // we are using compressed instructions so do use the lower 2 bits for prediction
-    localparam ANTIALIAS_BITS = 8;
+    localparam NR_SETS = NR_ENTRIES / NR_WAYS;
     // number of bits we should use for prediction
-    localparam PREDICTION_BITS = $clog2(NR_ENTRIES) + OFFSET;
-    // typedef for all branch target entries
-    // we may want to try to put a tag field that fills the rest of the PC in-order to mitigate aliasing effects
-    ariane_pkg::btb_prediction_t btb_d [NR_ENTRIES-1:0], btb_q [NR_ENTRIES-1:0];
-    logic [$clog2(NR_ENTRIES)-1:0]          index, update_pc;
+    localparam PREDICTION_BITS = $clog2(NR_SETS) + OFFSET;
+    // position of a way in the LRU order, 0 is the most recently used one
+    localparam WAY_BITS = (NR_WAYS > 1) ? $clog2(NR_WAYS) : 1;
 
-    assign index     = vpc_i[PREDICTION_BITS - 1:OFFSET];
-    assign update_pc = btb_update_i.pc[PREDICTION_BITS - 1:OFFSET];
+    struct packed {
+        logic                valid;
+        logic [TAG_BITS-1:0] tag;
+        logic [63:0]         target_address;
+    } btb_d [NR_SETS-1:0][NR_WAYS-1:0], btb_q [NR_SETS-1:0][NR_WAYS-1:0];
+
+    logic [WAY_BITS-1:0]        lru_d [NR_SETS-1:0][NR_WAYS-1:0], lru_q [NR_SETS-1:0][NR_WAYS-1:0];
+    logic [$clog2(NR_SETS)-1:0] index, update_index;
+    logic [TAG_BITS-1:0]        tag, update_tag;
+
+    assign index        = vpc_i[PREDICTION_BITS - 1:OFFSET];
+    assign update_index = btb_update_i.pc[PREDICTION_BITS - 1:OFFSET];
+    assign tag          = vpc_i[PREDICTION_BITS +: TAG_BITS];
+    assign update_tag   = btb_update_i.pc[PREDICTION_BITS +: TAG_BITS];
 
     // output matching prediction
-    assign btb_prediction_o = btb_q[index];
+    always_comb begin : lookup
+        btb_prediction_o = '0;
+
+        for (int unsigned i = 0; i < NR_WAYS; i++) begin
+            if (btb_q[index][i].valid && btb_q[index][i].tag == tag) begin
+                btb_prediction_o.valid          = 1'b1;
+                btb_prediction_o.target_address = btb_q[index][i].target_address;
+            end
+        end
+    end
 
     // -------------------------
     // Update Branch Prediction
     // -------------------------
-    // update on a mis-predict
     always_comb begin : update_branch_predict
+        automatic logic                hit;
+        automatic logic [WAY_BITS-1:0] way;
+
         btb_d = btb_q;
+        lru_d = lru_q;
+
+        // the way which already holds this PC, otherwise an empty way and
+        // if there is none the least recently used one
+        hit = 1'b0;
+        way = '0;
+        for (int unsigned i = 0; i < NR_WAYS; i++)
+            if (lru_q[update_index][i] == NR_WAYS - 1)
+                way = i[WAY_BITS-1:0];
+        for (int unsigned i = 0; i < NR_WAYS; i++)
+            if (!btb_q[update_index][i].valid)
+                way = i[WAY_BITS-1:0];
+        for (int unsigned i = 0; i < NR_WAYS; i++) begin
+            if (btb_q[update_index][i].valid && btb_q[update_index][i].tag == update_tag) begin
+                hit = 1'b1;
+                way = i[WAY_BITS-1:0];
+            end
+        end
 
         if (btb_update_i.valid && !debug_mode_i) begin
-            btb_d[update_pc].valid = 1'b1;
-            // the target address is simply updated
-            btb_d[update_pc].target_address = btb_update_i.target_address;
             // check if we should invalidate this entry, this happens in case we predicted a branch
             // where actually none-is (aliasing)
             if (btb_update_i.clear) begin
-                btb_d[update_pc].valid = 1'b0;
+                if (hit)
+                    btb_d[update_index][way].valid = 1'b0;
+            end else begin
+                btb_d[update_index][way].valid = 1'b1;
+                btb_d[update_index][way].tag   = update_tag;
+                // the target address is simply updated
+                btb_d[update_index][way].target_address = btb_update_i.target_address;
+                // make it the most recently used way
+                for (int unsigned i = 0; i < NR_WAYS; i++)
+                    if (lru_q[update_index][i] < lru_q[update_index][way])
+                        lru_d[update_index][i] = lru_q[update_index][i] + 1;
+                lru_d[update_index][way] = '0;
             end
         end
     end
@@ -68,18 +121,31 @@ module btb #(
     // sequential process
     always_ff @(posedge clk_i or negedge rst_ni) begin
         if (~rst_ni) begin
-            // Bias the branches to be taken upon first arrival
-            for (int i = 0; i < NR_ENTRIES; i++)
-                btb_q[i] <= '{default: 0};
+            for (int unsigned i = 0; i < NR_SETS; i++) begin
+                for (int unsigned j = 0; j < NR_WAYS; j++) begin
+                    btb_q[i][j] <= '0;
+                    lru_q[i][j] <= j[WAY_BITS-1:0];
+                end
+            end
         end else begin
             // evict all entries
             if (flush_i) begin
-                for (int i = 0; i < NR_ENTRIES; i++) begin
-                    btb_q[i].valid <=  1'b0;
-                end
+                for (int unsigned i = 0; i < NR_SETS; i++)
+                    for (int unsigned j = 0; j < NR_WAYS; j++)
+                        btb_q[i][j].valid <= 1'b0;
             end else begin
-                btb_q <=  btb_d;
+                btb_q <= btb_d;
+                lru_q <= lru_d;
             end
         end
     end
+
+//pragma translate_off
+`ifndef VERILATOR
+    initial begin
+        assert (NR_ENTRIES % NR_WAYS == 0 && NR_SETS > 1)
+            else $fatal(1, "[btb] the entries must be split into at least two sets of NR_WAYS");
+    end
+`endif
+//pragma translate_on
 endmodule
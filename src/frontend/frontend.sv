@@ -56,11 +56,20 @@ module frontend #(
     // BHT, BTB and RAS prediction
     bht_prediction_t bht_prediction;
     btb_prediction_t btb_prediction;
+    btb_prediction_t ind_prediction;
+    btb_prediction_t jalr_prediction;
     ras_t            ras_predict;
     bht_update_t     bht_update;
     btb_update_t     btb_update;
     logic            ras_push, ras_pop;
     logic [63:0]     ras_update;
+    ras_ptr_t        ras_ptr;
+    // global branch history (gshare)
+    logic                        bht_shift, bht_shift_taken;
+    logic [BHT_HISTORY_BITS-1:0] bht_history;
+    // path history of the indirect jumps
+    logic                         ind_shift;
+    logic [PATH_HISTORY_BITS-1:0] path_history;
 
     // instruction fetch is ready
     logic          if_ready;
@@ -182,7 +191,11 @@ module frontend #(
         bp_vaddr          = '0;    // predicted address
         bp_valid          = 1'b0;  // prediction is valid
 
-        bp_sbe.cf_type    = RAS;
+        bp_sbe.cf_type    = NO_CF;
+
+        bht_shift         = 1'b0;
+        bht_shift_taken   = 1'b0;
+        ind_shift         = 1'b0;
 
         // only predict if the response is valid
         if (instruction_valid) begin
@@ -207,6 +220,9 @@ module frontend #(
                             take_rvi_cf = rvi_branch[i] & rvi_imm[i][63];
                             take_rvc_cf = rvc_branch[i] & rvc_imm[i][63];
                         end
+                        // one history bit per fetch, all branches in it share the prediction
+                        bht_shift = 1'b1;
+                        bht_shift_taken = take_rvi_cf | take_rvc_cf;
                     end
 
                     // unconditional jumps
@@ -216,11 +232,13 @@ module frontend #(
                     end
 
                     // to take this jump we need a valid prediction target **speculative**
-                    if ((rvi_jalr[i] || rvc_jalr[i]) && ~(rvi_call[i] || rvc_call[i])) begin
+                    // this covers indirect calls and jumps, only returns are left to the RAS
+                    if ((rvi_jalr[i] && ~rvi_return[i]) || (rvc_jr[i] && ~rvc_return[i]) || rvc_jalr[i]) begin
                         bp_sbe.cf_type = BTB;
-                        if (btb_prediction.valid) begin
-                            bp_vaddr = btb_prediction.target_address;
+                        if (jalr_prediction.valid) begin
+                            bp_vaddr = jalr_prediction.target_address;
                             taken[i+1] = 1'b1;
+                            ind_shift = 1'b1;
                         end
                     end
 
@@ -248,6 +266,14 @@ module frontend #(
                         // TODO(zarubaf): that seems to be overly pessimistic
                         ras_pop = 1'b0;
                         ras_push = 1'b0;
+                        ind_shift = 1'b0;
+                        // a branch in the upper half is resolved like any other and its outcome is
+                        // appended to the restored history on a mis-predict, so it shifts here too.
+                        // The lower half must neither shift nor mark the fetch as a branch.
+                        if (i == 0) begin
+                            bht_shift = 1'b0;
+                            bp_sbe.cf_type = NO_CF;
+                        end
                     end
                 end
             end
@@ -258,6 +284,10 @@ module frontend #(
         bp_sbe.valid = bp_valid;
         bp_sbe.predict_address = bp_vaddr;
         bp_sbe.predict_taken = bp_valid;
+        bp_sbe.history = bht_history;
+        bp_sbe.path_history = path_history;
+        // top of stack once the RAS has been updated with this fetch
+        bp_sbe.ras_ptr = ras_ptr;
     end
 
     assign is_mispredict = resolved_branch_i.valid & resolved_branch_i.is_mispredict;
@@ -275,11 +305,14 @@ module frontend #(
     assign bht_update.pc    = resolved_branch_i.pc;
     assign bht_update.mispredict = resolved_branch_i.is_mispredict;
     assign bht_update.taken = resolved_branch_i.is_taken;
+    assign bht_update.history = resolved_branch_i.history;
     // BTB
     assign btb_update.valid = resolved_branch_i.valid & (resolved_branch_i.cf_type == BTB);
     assign btb_update.pc    = resolved_branch_i.pc;
     assign btb_update.target_address = resolved_branch_i.target_address;
     assign btb_update.clear = resolved_branch_i.clear;
+    assign btb_update.mispredict = resolved_branch_i.is_mispredict;
+    assign btb_update.path_history = resolved_branch_i.path_history;
 
     // -------------------
     // Next PC
@@ -429,17 +462,22 @@ module frontend #(
     end
 
     ras #(
-        .DEPTH  ( RAS_DEPTH   )
+        .DEPTH         ( RAS_DEPTH                  )
     ) i_ras (
-        .push_i ( ras_push    ),
-        .pop_i  ( ras_pop     ),
-        .data_i ( ras_update  ),
-        .data_o ( ras_predict ),
+        .push_i        ( ras_push                   ),
+        .pop_i         ( ras_pop                    ),
+        .data_i        ( ras_update                 ),
+        .restore_i     ( is_mispredict              ),
+        .restore_ptr_i ( resolved_branch_i.ras_ptr  ),
+        .ptr_o         ( ras_ptr                    ),
+        .data_o        ( ras_predict                ),
         .*
     );
 
     btb #(
-        .NR_ENTRIES       ( BTB_ENTRIES      )
+        .NR_ENTRIES       ( BTB_ENTRIES      ),
+        .NR_WAYS          ( BTB_WAYS         ),
+        .TAG_BITS         ( BTB_TAG_BITS     )
     ) i_btb (
         .clk_i,
         .rst_ni,
@@ -450,17 +488,80 @@ module frontend #(
         .btb_prediction_o ( btb_prediction   )
     );
 
-    bht #(
-        .NR_ENTRIES       ( BHT_ENTRIES      )
-    ) i_bht (
-        .clk_i,
-        .rst_ni,
-        .flush_i          ( flush_bp_i       ),
-        .debug_mode_i,
-        .vpc_i            ( icache_vaddr_q   ),
-        .bht_update_i     ( bht_update       ),
-        .bht_prediction_o ( bht_prediction   )
-    );
+    if (INDIRECT_PREDICTOR) begin : gen_indirect_predictor
+        // a mis-predicted indirect jump continues with its own target, everything
+        // else with the history it has been fetched with
+        logic [PATH_HISTORY_BITS-1:0] restore_path_history;
+        assign restore_path_history = (resolved_branch_i.cf_type == BTB) ?
+                                      {resolved_branch_i.path_history[PATH_HISTORY_BITS-3:0], resolved_branch_i.target_address[2:1]} :
+                                      resolved_branch_i.path_history;
+
+        indirect_predictor #(
+            .NR_ENTRIES        ( INDIRECT_ENTRIES     ),
+            .HISTORY_BITS      ( PATH_HISTORY_BITS    ),
+            .TAG_BITS          ( BTB_TAG_BITS         )
+        ) i_indirect_predictor (
+            .clk_i,
+            .rst_ni,
+            .flush_i           ( flush_bp_i           ),
+            .debug_mode_i,
+            .vpc_i             ( icache_vaddr_q       ),
+            .shift_i           ( ind_shift & ~icache_dreq_o.kill_s1 ),
+            .shift_target_i    ( bp_vaddr             ),
+            .restore_i         ( is_mispredict        ),
+            .restore_history_i ( restore_path_history ),
+            .history_o         ( path_history         ),
+            .btb_update_i      ( btb_update           ),
+            .btb_prediction_o  ( ind_prediction       )
+        );
+    end else begin : gen_no_indirect_predictor
+        assign path_history   = '0;
+        assign ind_prediction = '0;
+    end
+
+    // the indirect predictor only knows the jumps which changed their target
+    assign jalr_prediction = ind_prediction.valid ? ind_prediction : btb_prediction;
+
+    if (BHT_GSHARE) begin : gen_gshare
+        // a mis-predicted branch continues with its own outcome, everything
+        // else with the history it has been fetched with
+        logic [BHT_HISTORY_BITS-1:0] restore_history;
+        assign restore_history = (resolved_branch_i.cf_type == BHT) ?
+                                 {resolved_branch_i.history[BHT_HISTORY_BITS-2:0], resolved_branch_i.is_taken} :
+                                 resolved_branch_i.history;
+
+        gshare #(
+            .NR_ENTRIES        ( BHT_ENTRIES      ),
+            .HISTORY_BITS      ( BHT_HISTORY_BITS )
+        ) i_bht (
+            .clk_i,
+            .rst_ni,
+            .flush_i           ( flush_bp_i       ),
+            .debug_mode_i,
+            .vpc_i             ( icache_vaddr_q   ),
+            .shift_i           ( bht_shift & ~icache_dreq_o.kill_s1 ),
+            .shift_taken_i     ( bht_shift_taken  ),
+            .restore_i         ( is_mispredict    ),
+            .restore_history_i ( restore_history  ),
+            .history_o         ( bht_history      ),
+            .bht_update_i      ( bht_update       ),
+            .bht_prediction_o  ( bht_prediction   )
+        );
+    end else begin : gen_bht
+        assign bht_history = '0;
+
+        bht #(
+            .NR_ENTRIES       ( BHT_ENTRIES      )
+        ) i_bht (
+            .clk_i,
+            .rst_ni,
+            .flush_i          ( flush_bp_i       ),
+            .debug_mode_i,
+            .vpc_i            ( icache_vaddr_q   ),
+            .bht_update_i     ( bht_update       ),
+            .bht_prediction_o ( bht_prediction   )
+        );
+    end
 
     for (genvar i = 0; i < INSTR_PER_FETCH; i++) begin
         instr_scan i_instr_scan (
@@ -0,0 +1,126 @@
+// Copyright 2018 ETH Zurich and University of Bologna.
+// Copyright and related rights are licensed under the Solderpad Hardware
+// License, Version 0.51 (the "License"); you may not use this file except in
+// compliance with the License.  You may obtain a copy of the License at
+// http://solderpad.org/licenses/SHL-0.51. Unless required by applicable law
+// or agreed to in writing, software, hardware and materials distributed under
+// this License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+//
+// Description: gshare branch predictor - 2 bit saturation counters indexed
+//              by the PC xor'ed with the global branch history
+
+// The global history is updated speculatively with the predicted outcome of
+// every fetch which contains a conditional branch. The history a prediction
+// has been made with travels down the pipeline with the instruction
+// (branchpredict_sbe_t) and comes back with the resolved branch, it is used
+// to update the very same counter and to repair the history on a mis-predict.
+module gshare #(
+    parameter int unsigned NR_ENTRIES   = 1024,
+    parameter int unsigned HISTORY_BITS = 10
+)(
+    input  logic                        clk_i,
+    input  logic                        rst_ni,
+    input  logic                        flush_i,
+    input  logic                        debug_mode_i,
+
+    input  logic [63:0]                 vpc_i,
+    // a conditional branch has been predicted in this fetch
+    input  logic                        shift_i,
+    input  logic                        shift_taken_i,
+    // mis-predict: continue with the history of the resolved instruction
+    input  logic                        restore_i,
+    input  logic [HISTORY_BITS-1:0]     restore_history_i,
+    // history the current prediction is based on
+    output logic [HISTORY_BITS-1:0]     history_o,
+    input  ariane_pkg::bht_update_t     bht_update_i,
+    output ariane_pkg::bht_prediction_t bht_prediction_o
+);
+    localparam OFFSET = 2; // we are using compressed instructions so do not use the lower 2 bits for prediction
+    // number of bits we should use for prediction
+    localparam PREDICTION_BITS = $clog2(NR_ENTRIES) + OFFSET;
+
+    struct packed {
+        logic       valid;
+        logic [1:0] saturation_counter;
+    } bht_d[NR_ENTRIES-1:0], bht_q[NR_ENTRIES-1:0];
+
+    logic [HISTORY_BITS-1:0]        history_d, history_q;
+    logic [$clog2(NR_ENTRIES)-1:0]  index, update_index;
+    logic [1:0]                     saturation_counter;
+
+    assign history_o = history_q;
+
+    // the history gets folded onto the lower index bits
+    assign index        = vpc_i[PREDICTION_BITS - 1:OFFSET] ^ history_q;
+    assign update_index = bht_update_i.pc[PREDICTION_BITS - 1:OFFSET] ^ bht_update_i.history;
+    // prediction assignment
+    assign bht_prediction_o.valid = bht_q[index].valid;
+    assign bht_prediction_o.taken = bht_q[index].saturation_counter == 2'b10;
+    assign bht_prediction_o.strongly_taken = (bht_q[index].saturation_counter == 2'b11);
+
+    always_comb begin : update_history
+        history_d = history_q;
+
+        if (shift_i)
+            history_d = {history_q[HISTORY_BITS-2:0], shift_taken_i};
+        // a mis-predict kills everything which has been fetched after it
+        if (restore_i)
+            history_d = restore_history_i;
+    end
+
+    always_comb begin : update_bht
+        bht_d = bht_q;
+        saturation_counter = bht_q[update_index].saturation_counter;
+
+        if (bht_update_i.valid && !debug_mode_i) begin
+            bht_d[update_index].valid = 1'b1;
+
+            if (saturation_counter == 2'b11) begin
+                // we can safely decrease it
+                if (~bht_update_i.taken)
+                    bht_d[update_index].saturation_counter = saturation_counter - 1;
+            // then check if it saturated in the negative regime e.g.: branch not taken
+            end else if (saturation_counter == 2'b00) begin
+                // we can safely increase it
+                if (bht_update_i.taken)
+                    bht_d[update_index].saturation_counter = saturation_counter + 1;
+            end else begin // otherwise we are not in any boundaries and can decrease or increase it
+                if (bht_update_i.taken)
+                    bht_d[update_index].saturation_counter = saturation_counter + 1;
+                else
+                    bht_d[update_index].saturation_counter = saturation_counter - 1;
+            end
+        end
+    end
+
+    always_ff @(posedge clk_i or negedge rst_ni) begin
+        if (~rst_ni) begin
+            history_q <= '0;
+            for (int unsigned i = 0; i < NR_ENTRIES; i++)
+                bht_q[i] <= '0;
+        end else begin
+            history_q <= history_d;
+            // evict all entries
+            if (flush_i) begin
+                history_q <= '0;
+                for (int i = 0; i < NR_ENTRIES; i++) begin
+                    bht_q[i].valid <=  1'b0;
+                    bht_q[i].saturation_counter <= 2'b10;
+                end
+            end else begin
+                bht_q <= bht_d;
+            end
+        end
+    end
+
+//pragma translate_off
+`ifndef VERILATOR
+    initial begin
+        assert (HISTORY_BITS > 1 && HISTORY_BITS <= $clog2(NR_ENTRIES))
+            else $fatal(1, "[gshare] history must be wider than one bit and at most as wide as the index");
+    end
+`endif
+//pragma translate_on
+endmodule
@@ -0,0 +1,126 @@
+// Copyright 2018 ETH Zurich and University of Bologna.
+// Copyright and related rights are licensed under the Solderpad Hardware
+// License, Version 0.51 (the "License"); you may not use this file except in
+// compliance with the License.  You may obtain a copy of the License at
+// http://solderpad.org/licenses/SHL-0.51. Unless required by applicable law
+// or agreed to in writing, software, hardware and materials distributed under
+// this License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+//
+// Description: Indirect jump target predictor - target cache indexed by the
+//              PC xor'ed with the path history of the last indirect jumps
+
+// The BTB holds a single target per jump which is fine for most indirect
+// jumps, but a jump through a function pointer table or a switch table
+// changes its target with the path the program took to get there. The path
+// history contains two bits of each of the last targets and is updated
+// speculatively when an indirect jump is predicted. As for gshare the history
+// travels with the instruction and comes back with the resolved branch.
+// An entry is only allocated once a jump has been mis-predicted, jumps which
+// always go to the same target stay in the BTB alone. Entries are tagged with
+// the PC so that a prediction is only made for the jump which installed it.
+module indirect_predictor #(
+    parameter int unsigned NR_ENTRIES   = 64,
+    parameter int unsigned HISTORY_BITS = 6,
+    parameter int unsigned TAG_BITS     = 8
+)(
+    input  logic                        clk_i,
+    input  logic                        rst_ni,
+    input  logic                        flush_i,
+    input  logic                        debug_mode_i,
+
+    input  logic [63:0]                 vpc_i,
+    // an indirect jump has been predicted in this fetch
+    input  logic                        shift_i,
+    input  logic [63:0]                 shift_target_i,
+    // mis-predict: continue with the history of the resolved instruction
+    input  logic                        restore_i,
+    input  logic [HISTORY_BITS-1:0]     restore_history_i,
+    // history the current prediction is based on
+    output logic [HISTORY_BITS-1:0]     history_o,
+    input  ariane_pkg::btb_update_t     btb_update_i,
+    output ariane_pkg::btb_prediction_t btb_prediction_o
+);
+    localparam OFFSET = 1; // we are using compressed instructions so do use the lower 2 bits for prediction
+    // number of bits we should use for prediction
+    localparam PREDICTION_BITS = $clog2(NR_ENTRIES) + OFFSET;
+
+    struct packed {
+        logic                valid;
+        logic [TAG_BITS-1:0] tag;
+        logic [63:0]         target_address;
+    } itb_d [NR_ENTRIES-1:0], itb_q [NR_ENTRIES-1:0];
+
+    logic [HISTORY_BITS-1:0]        history_d, history_q;
+    logic [$clog2(NR_ENTRIES)-1:0]  index, update_index;
+    logic [TAG_BITS-1:0]            tag, update_tag;
+
+    assign history_o = history_q;
+
+    // the history gets folded onto the lower index bits
+    assign index        = vpc_i[PREDICTION_BITS - 1:OFFSET] ^ history_q;
+    assign update_index = btb_update_i.pc[PREDICTION_BITS - 1:OFFSET] ^ btb_update_i.path_history;
+    assign tag          = vpc_i[PREDICTION_BITS +: TAG_BITS];
+    assign update_tag   = btb_update_i.pc[PREDICTION_BITS +: TAG_BITS];
+    // prediction assignment
+    assign btb_prediction_o.valid          = itb_q[index].valid && itb_q[index].tag == tag;
+    assign btb_prediction_o.target_address = itb_q[index].target_address;
+
+    always_comb begin : update_history
+        history_d = history_q;
+
+        if (shift_i)
+            history_d = {history_q[HISTORY_BITS-3:0], shift_target_i[OFFSET+:2]};
+        // a mis-predict kills everything which has been fetched after it
+        if (restore_i)
+            history_d = restore_history_i;
+    end
+
+    always_comb begin : update_itb
+        automatic logic hit;
+
+        itb_d = itb_q;
+        hit = itb_q[update_index].valid && itb_q[update_index].tag == update_tag;
+
+        if (btb_update_i.valid && !debug_mode_i) begin
+            // predicted a jump where there is none
+            if (btb_update_i.clear) begin
+                if (hit)
+                    itb_d[update_index].valid = 1'b0;
+            // follow the target of an entry we own, replace the entry on a mis-predict
+            end else if (hit || btb_update_i.mispredict) begin
+                itb_d[update_index].valid          = 1'b1;
+                itb_d[update_index].tag            = update_tag;
+                itb_d[update_index].target_address = btb_update_i.target_address;
+            end
+        end
+    end
+
+    always_ff @(posedge clk_i or negedge rst_ni) begin
+        if (~rst_ni) begin
+            history_q <= '0;
+            for (int unsigned i = 0; i < NR_ENTRIES; i++)
+                itb_q[i] <= '0;
+        end else begin
+            history_q <= history_d;
+            // evict all entries
+            if (flush_i) begin
+                history_q <= '0;
+                for (int unsigned i = 0; i < NR_ENTRIES; i++)
+                    itb_q[i].valid <= 1'b0;
+            end else begin
+                itb_q <= itb_d;
+            end
+        end
+    end
+
+//pragma translate_off
+`ifndef VERILATOR
+    initial begin
+        assert (HISTORY_BITS > 2 && HISTORY_BITS % 2 == 0 && HISTORY_BITS <= $clog2(NR_ENTRIES))
+            else $fatal(1, "[indirect_predictor] history must hold at least two targets and be at most as wide as the index");
+    end
+`endif
+//pragma translate_on
+endmodule
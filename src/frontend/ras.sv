@@ -14,45 +14,78 @@
 // Date: 09.06.2018
 
 // return address stack
+// The stack is a circular buffer, overflowing it overwrites the oldest entry.
+// The number of valid entries is counted so that popping an empty stack gives
+// no prediction instead of a stale return address. The top of stack pointer
+// and the count after a fetch travel down the pipeline with the instruction
+// (branchpredict_sbe_t), on a mis-predict they are restored so that the
+// pushes and pops of the wrong path are undone. Entries which have been
+// overwritten on the wrong path are not repaired.
 module ras #(
     parameter int unsigned DEPTH = 2
 )(
-    input  logic             clk_i,
-    input  logic             rst_ni,
-    input  logic             push_i,
-    input  logic             pop_i,
-    input  logic [63:0]      data_i,
-    output ariane_pkg::ras_t data_o
+    input  logic                     clk_i,
+    input  logic                     rst_ni,
+    input  logic                     push_i,
+    input  logic                     pop_i,
+    input  logic [63:0]              data_i,
+    // mis-predict: continue with the state after the resolved instruction
+    input  logic                     restore_i,
+    input  ariane_pkg::ras_ptr_t     restore_ptr_i,
+    output ariane_pkg::ras_ptr_t     ptr_o,         // state after this cycle's push and pop
+    output ariane_pkg::ras_t         data_o
 );
 
     ariane_pkg::ras_t [DEPTH-1:0] stack_d, stack_q;
+    ariane_pkg::ras_ptr_t         ptr_d, ptr_q;
 
-    assign data_o = stack_q[0];
+    assign data_o.ra    = stack_q[ptr_q.tos].ra;
+    assign data_o.valid = stack_q[ptr_q.tos].valid && (ptr_q.cnt != '0);
 
     always_comb begin
         stack_d = stack_q;
+        ptr_d   = ptr_q;
+
+        // a pop and a push in the same cycle replace the top entry
+        if (pop_i) begin
+            ptr_d.tos = (ptr_q.tos == 0) ? DEPTH - 1 : ptr_q.tos - 1;
+            if (ptr_q.cnt != '0)
+                ptr_d.cnt = ptr_q.cnt - 1;
+        end
 
         // push on the stack
         if (push_i) begin
-            stack_d[0].ra = data_i;
+            ptr_d.tos = (ptr_d.tos == DEPTH - 1) ? 0 : ptr_d.tos + 1;
+            if (ptr_d.cnt != DEPTH)
+                ptr_d.cnt = ptr_d.cnt + 1;
+            stack_d[ptr_d.tos].ra = data_i;
             // mark the new return address as valid
-            stack_d[0].valid = 1'b1;
-            stack_d[DEPTH-1:1] = stack_q[DEPTH-2:0];
+            stack_d[ptr_d.tos].valid = 1'b1;
         end
 
-        if (pop_i) begin
-            stack_d[DEPTH-2:0] = stack_q[DEPTH-1:1];
-            // we popped the value so invalidate the end of the stack
-            stack_d[DEPTH-1].valid = 1'b0;
-            stack_d[DEPTH-1].ra = 'b0;
+        ptr_o = ptr_d;
+
+        if (restore_i) begin
+            ptr_d = restore_ptr_i;
         end
     end
 
     always_ff @(posedge clk_i or negedge rst_ni) begin
         if (~rst_ni) begin
             stack_q <= '0;
+            ptr_q   <= '0;
         end else begin
             stack_q <= stack_d;
+            ptr_q   <= ptr_d;
         end
     end
+
+//pragma translate_off
+`ifndef VERILATOR
+    initial begin
+        assert (DEPTH > 1) else $fatal(1, "[ras] the return address stack needs at least two entries");
+        assert (DEPTH == ariane_pkg::RAS_DEPTH) else $fatal(1, "[ras] ras_ptr_t is sized for RAS_DEPTH entries");
+    end
+`endif
+//pragma translate_on
 endmodule
@@ -25,11 +25,11 @@ module id_stage (
     input  logic                  fetch_entry_valid_i,
     output logic                  decoded_instr_ack_o, // acknowledge the instruction (fetch entry)
 
-    // to ID
-    output scoreboard_entry_t     issue_entry_o,       // a decoded instruction
-    output logic                  issue_entry_valid_o, // issue entry is valid
-    output logic                  is_ctrl_flow_o,      // the instruction we issue is a ctrl flow instructions
-    input  logic                  issue_instr_ack_i,   // issue stage acknowledged sampling of instructions
+    // to ID, the oldest instruction is on port 0
+    output scoreboard_entry_t [ISSUE_WIDTH-1:0] issue_entry_o,       // a decoded instruction
+    output logic              [ISSUE_WIDTH-1:0] issue_entry_valid_o, // issue entry is valid
+    output logic                                is_ctrl_flow_o,      // the instruction we issue is a ctrl flow instructions
+    input  logic              [ISSUE_WIDTH-1:0] issue_instr_ack_i,   // issue stage acknowledged sampling of instructions
     // from CSR file
     input  riscv::priv_lvl_t      priv_lvl_i,          // current privilege level
     input  riscv::xs_t            fs_i,                // floating point extension status
@@ -40,12 +40,13 @@ module id_stage (
     input  logic                  tw_i,
     input  logic                  tsr_i
 );
-    // register stage
+    // register stage, with more than one issue lane this is a small queue
+    // which gets filled while the issue stage is stalled
     struct packed {
         logic              valid;
         scoreboard_entry_t sbe;
         logic              is_ctrl_flow;
-    } issue_n, issue_q;
+    } [ISSUE_WIDTH-1:0] issue_n, issue_q;
 
     logic                is_control_flow_instr;
     scoreboard_entry_t   decoded_instruction;
@@ -101,29 +102,46 @@ module id_stage (
     // ------------------
     // Pipeline Register
     // ------------------
-    assign issue_entry_o = issue_q.sbe;
-    assign issue_entry_valid_o = issue_q.valid;
-    assign is_ctrl_flow_o = issue_q.is_ctrl_flow;
+    for (genvar i = 0; i < ISSUE_WIDTH; i++) begin : gen_issue_entry
+        assign issue_entry_o[i]       = issue_q[i].sbe;
+        assign issue_entry_valid_o[i] = issue_q[i].valid;
+    end
+    assign is_ctrl_flow_o = issue_q[0].is_ctrl_flow;
 
     always_comb begin
+        automatic int unsigned issued;
+
         issue_n     = issue_q;
         fetch_ack_i = 1'b0;
+        // the issue stage acknowledges in order, starting with the oldest entry
+        issued = 0;
+        for (int unsigned i = 0; i < ISSUE_WIDTH; i++)
+            if (issue_instr_ack_i[i])
+                issued++;
 
         // Clear the valid flag if issue has acknowledged the instruction
-        if (issue_instr_ack_i)
-            issue_n.valid = 1'b0;
+        // and move the remaining instructions to the front
+        for (int unsigned i = 0; i < ISSUE_WIDTH; i++) begin
+            if (i + issued < ISSUE_WIDTH)
+                issue_n[i] = issue_q[i + issued];
+            else
+                issue_n[i].valid = 1'b0;
+        end
 
         // if we have a space in the register and the fetch is valid, go get it
         // or the issue stage is currently acknowledging an instruction, which means that we will have space
         // for a new instruction
-        if ((!issue_q.valid || issue_instr_ack_i) && fetch_entry_valid) begin
-            fetch_ack_i = 1'b1;
-            issue_n = {1'b1, decoded_instruction, is_control_flow_instr};
+        for (int unsigned i = 0; i < ISSUE_WIDTH; i++) begin
+            if (!issue_n[i].valid && fetch_entry_valid && !fetch_ack_i) begin
+                fetch_ack_i = 1'b1;
+                issue_n[i]  = {1'b1, decoded_instruction, is_control_flow_instr};
+            end
         end
 
         // invalidate the pipeline register on a flush
         if (flush_i)
-            issue_n.valid = 1'b0;
+            for (int unsigned i = 0; i < ISSUE_WIDTH; i++)
+                issue_n[i].valid = 1'b0;
     end
     // -------------------------
     // Registers (ID <-> Issue)
@@ -22,30 +22,33 @@ module issue_read_operands #(
     input  logic                                   rst_ni,   // Asynchronous reset active low
     // flush
     input  logic                                   flush_i,
-    // coming from rename
-    input  scoreboard_entry_t                      issue_instr_i,
-    input  logic                                   issue_instr_valid_i,
-    output logic                                   issue_ack_o,
+    // coming from rename, the oldest instruction is on lane 0
+    input  scoreboard_entry_t [ISSUE_WIDTH-1:0]    issue_instr_i,
+    input  logic [ISSUE_WIDTH-1:0]                 issue_instr_valid_i,
+    output logic [ISSUE_WIDTH-1:0]                 issue_ack_o,
     // lookup rd in scoreboard
-    output logic [REG_ADDR_SIZE-1:0]               rs1_o,
-    input  logic [63:0]                            rs1_i,
-    input  logic                                   rs1_valid_i,
-    output logic [REG_ADDR_SIZE-1:0]               rs2_o,
-    input  logic [63:0]                            rs2_i,
-    input  logic                                   rs2_valid_i,
+    output logic [ISSUE_WIDTH-1:0][REG_ADDR_SIZE-1:0] rs1_o,
+    input  logic [ISSUE_WIDTH-1:0][63:0]           rs1_i,
+    input  logic [ISSUE_WIDTH-1:0]                 rs1_valid_i,
+    output logic [ISSUE_WIDTH-1:0][REG_ADDR_SIZE-1:0] rs2_o,
+    input  logic [ISSUE_WIDTH-1:0][63:0]           rs2_i,
+    input  logic [ISSUE_WIDTH-1:0]                 rs2_valid_i,
     output logic [REG_ADDR_SIZE-1:0]               rs3_o,
     input  logic [FLEN-1:0]                        rs3_i,
     input  logic                                   rs3_valid_i,
     // get clobber input
     input  fu_t [2**REG_ADDR_SIZE:0]               rd_clobber_gpr_i,
     input  fu_t [2**REG_ADDR_SIZE:0]               rd_clobber_fpr_i,
-    // To FU, just single issue for now
+    // To FU, all but ALU instructions are issued on lane 0
     output fu_data_t                               fu_data_o,
     output logic [63:0]                            pc_o,
     output logic                                   is_compressed_instr_o,
     // ALU 1
     input  logic                                   flu_ready_i,      // Fixed latency unit ready to accept a new request
     output logic                                   alu_valid_o,      // Output is valid
+    // ALU 2, only used by the second issue lane
+    output fu_data_t                               alu2_fu_data_o,
+    output logic                                   alu2_valid_o,     // Output is valid
     // Branches and Jumps
     output logic                                   branch_valid_o,   // this is a valid branch instruction
     output branchpredict_sbe_t                     branch_predict_o,
@@ -98,7 +101,7 @@ module issue_read_operands #(
 
     // original instruction stored in tval
     riscv::instruction_t orig_instr;
-    assign orig_instr = riscv::instruction_t'(issue_instr_i.ex.tval[31:0]);
+    assign orig_instr = riscv::instruction_t'(issue_instr_i[0].ex.tval[31:0]);
 
     // ID <-> EX registers
     assign fu_data_o.operand_a = operand_a_q;
@@ -122,7 +125,7 @@ module issue_read_operands #(
     // select the right busy signal
     // this obviously depends on the functional unit we need
     always_comb begin : unit_busy
-        unique case (issue_instr_i.fu)
+        unique case (issue_instr_i[0].fu)
             NONE:
                 fu_busy = 1'b0;
             ALU, CTRL_FLOW, CSR, MULT:
@@ -148,37 +151,37 @@ module issue_read_operands #(
         forward_rs2 = 1'b0;
         forward_rs3 = 1'b0; // FPR only
         // poll the scoreboard for those values
-        rs1_o = issue_instr_i.rs1;
-        rs2_o = issue_instr_i.rs2;
-        rs3_o = issue_instr_i.result[REG_ADDR_SIZE-1:0]; // rs3 is encoded in imm field
+        rs1_o[0] = issue_instr_i[0].rs1;
+        rs2_o[0] = issue_instr_i[0].rs2;
+        rs3_o = issue_instr_i[0].result[REG_ADDR_SIZE-1:0]; // rs3 is encoded in imm field
 
         // 0. check that we are not using the zimm type in RS1
         //    as this is an immediate we do not have to wait on anything here
         // 1. check if the source registers are clobbered --> check appropriate clobber list (gpr/fpr)
         // 2. poll the scoreboard
-        if (~issue_instr_i.use_zimm && (is_rs1_fpr(issue_instr_i.op) ? rd_clobber_fpr_i[issue_instr_i.rs1] != NONE
-                                                                     : rd_clobber_gpr_i[issue_instr_i.rs1] != NONE)) begin
+        if (~issue_instr_i[0].use_zimm && (is_rs1_fpr(issue_instr_i[0].op) ? rd_clobber_fpr_i[issue_instr_i[0].rs1] != NONE
+                                                                           : rd_clobber_gpr_i[issue_instr_i[0].rs1] != NONE)) begin
             // check if the clobbering instruction is not a CSR instruction, CSR instructions can only
             // be fetched through the register file since they can't be forwarded
             // if the operand is available, forward it. CSRs don't write to/from FPR
-            if (rs1_valid_i && (is_rs1_fpr(issue_instr_i.op) ? 1'b1 : rd_clobber_gpr_i[issue_instr_i.rs1] != CSR)) begin
+            if (rs1_valid_i[0] && (is_rs1_fpr(issue_instr_i[0].op) ? 1'b1 : rd_clobber_gpr_i[issue_instr_i[0].rs1] != CSR)) begin
                 forward_rs1 = 1'b1;
             end else begin // the operand is not available -> stall
                 stall = 1'b1;
             end
         end
 
-        if (is_rs2_fpr(issue_instr_i.op) ? rd_clobber_fpr_i[issue_instr_i.rs2] != NONE
-                                         : rd_clobber_gpr_i[issue_instr_i.rs2] != NONE) begin
+        if (is_rs2_fpr(issue_instr_i[0].op) ? rd_clobber_fpr_i[issue_instr_i[0].rs2] != NONE
+                                            : rd_clobber_gpr_i[issue_instr_i[0].rs2] != NONE) begin
             // if the operand is available, forward it. CSRs don't write to/from FPR
-            if (rs2_valid_i && (is_rs2_fpr(issue_instr_i.op) ? 1'b1 : rd_clobber_gpr_i[issue_instr_i.rs2] != CSR)) begin
+            if (rs2_valid_i[0] && (is_rs2_fpr(issue_instr_i[0].op) ? 1'b1 : rd_clobber_gpr_i[issue_instr_i[0].rs2] != CSR)) begin
                 forward_rs2 = 1'b1;
             end else begin // the operand is not available -> stall
                 stall = 1'b1;
             end
         end
 
-        if (is_imm_fpr(issue_instr_i.op) && rd_clobber_fpr_i[issue_instr_i.result[REG_ADDR_SIZE-1:0]] != NONE) begin
+        if (is_imm_fpr(issue_instr_i[0].op) && rd_clobber_fpr_i[issue_instr_i[0].result[REG_ADDR_SIZE-1:0]] != NONE) begin
             // if the operand is available, forward it. CSRs don't write to/from FPR so no need to check
             if (rs3_valid_i) begin
                 forward_rs3 = 1'b1;
@@ -195,17 +198,17 @@ module issue_read_operands #(
         operand_b_n = operand_b_regfile;
         // immediates are the third operands in the store case
         // for FP operations, the imm field can also be the third operand from the regfile
-        imm_n      = is_imm_fpr(issue_instr_i.op) ? operand_c_regfile : issue_instr_i.result;
-        trans_id_n = issue_instr_i.trans_id;
-        fu_n       = issue_instr_i.fu;
-        operator_n = issue_instr_i.op;
+        imm_n      = is_imm_fpr(issue_instr_i[0].op) ? operand_c_regfile : issue_instr_i[0].result;
+        trans_id_n = issue_instr_i[0].trans_id;
+        fu_n       = issue_instr_i[0].fu;
+        operator_n = issue_instr_i[0].op;
         // or should we forward
         if (forward_rs1) begin
-            operand_a_n  = rs1_i;
+            operand_a_n  = rs1_i[0];
         end
 
         if (forward_rs2) begin
-            operand_b_n  = rs2_i;
+            operand_b_n  = rs2_i[0];
         end
 
         if (forward_rs3) begin
@@ -213,19 +216,19 @@ module issue_read_operands #(
         end
 
         // use the PC as operand a
-        if (issue_instr_i.use_pc) begin
-            operand_a_n = issue_instr_i.pc;
+        if (issue_instr_i[0].use_pc) begin
+            operand_a_n = issue_instr_i[0].pc;
         end
 
         // use the zimm as operand a
-        if (issue_instr_i.use_zimm) begin
+        if (issue_instr_i[0].use_zimm) begin
             // zero extend operand a
-            operand_a_n = {52'b0, issue_instr_i.rs1[4:0]};
+            operand_a_n = {52'b0, issue_instr_i[0].rs1[4:0]};
         end
         // or is it an immediate (including PC), this is not the case for a store and control flow instructions
         // also make sure operand B is not already used as an FP operand
-        if (issue_instr_i.use_imm && (issue_instr_i.fu != STORE) && (issue_instr_i.fu != CTRL_FLOW) && !is_rs2_fpr(issue_instr_i.op)) begin
-            operand_b_n = issue_instr_i.result;
+        if (issue_instr_i[0].use_imm && (issue_instr_i[0].fu != STORE) && (issue_instr_i[0].fu != CTRL_FLOW) && !is_rs2_fpr(issue_instr_i[0].op)) begin
+            operand_b_n = issue_instr_i[0].result;
         end
     end
 
@@ -242,8 +245,8 @@ module issue_read_operands #(
         // Exception pass through:
         // If an exception has occurred simply pass it through
         // we do not want to issue this instruction
-        if (~issue_instr_i.ex.valid && issue_instr_valid_i && issue_ack_o) begin
-            case (issue_instr_i.fu)
+        if (~issue_instr_i[0].ex.valid && issue_instr_valid_i[0] && issue_ack_o[0]) begin
+            case (issue_instr_i[0].fu)
                 ALU:
                     alu_valid_n    = 1'b1;
                 CTRL_FLOW:
@@ -284,26 +287,26 @@ module issue_read_operands #(
     // We also need to check if there is an unresolved branch in the scoreboard.
     always_comb begin : issue_scoreboard
         // default assignment
-        issue_ack_o = 1'b0;
+        issue_ack_o[0] = 1'b0;
         // check that we didn't stall, that the instruction we got is valid
         // and that the functional unit we need is not busy
-        if (issue_instr_valid_i) begin
+        if (issue_instr_valid_i[0]) begin
             // check that the corresponding functional unit is not busy
             if (~stall && ~fu_busy) begin
                 // -----------------------------------------
                 // WAW - Write After Write Dependency Check
                 // -----------------------------------------
                 // no other instruction has the same destination register -> issue the instruction
-                if (is_rd_fpr(issue_instr_i.op) ? (rd_clobber_fpr_i[issue_instr_i.rd] == NONE)
-                                                : (rd_clobber_gpr_i[issue_instr_i.rd] == NONE)) begin
-                    issue_ack_o = 1'b1;
+                if (is_rd_fpr(issue_instr_i[0].op) ? (rd_clobber_fpr_i[issue_instr_i[0].rd] == NONE)
+                                                   : (rd_clobber_gpr_i[issue_instr_i[0].rd] == NONE)) begin
+                    issue_ack_o[0] = 1'b1;
                 end
                 // or check that the target destination register will be written in this cycle by the
                 // commit stage
                 for (int unsigned i = 0; i < NR_COMMIT_PORTS; i++)
-                    if (is_rd_fpr(issue_instr_i.op) ? (we_fpr_i[i] && waddr_i[i] == issue_instr_i.rd)
-                                                    : (we_gpr_i[i] && waddr_i[i] == issue_instr_i.rd)) begin
-                        issue_ack_o = 1'b1;
+                    if (is_rd_fpr(issue_instr_i[0].op) ? (we_fpr_i[i] && waddr_i[i] == issue_instr_i[0].rd)
+                                                       : (we_gpr_i[i] && waddr_i[i] == issue_instr_i[0].rd)) begin
+                        issue_ack_o[0] = 1'b1;
                     end
             end
             // we can also issue the instruction under the following two circumstances:
@@ -311,39 +314,43 @@ module issue_read_operands #(
             // the decoder needs to make sure that the instruction is marked as valid when it does not
             // need any functional unit or if an exception occurred previous to the execute stage.
             // 1. we already got an exception
-            if (issue_instr_i.ex.valid) begin
-                issue_ack_o = 1'b1;
+            if (issue_instr_i[0].ex.valid) begin
+                issue_ack_o[0] = 1'b1;
             end
             // 2. it is an instruction which does not need any functional unit
-            if (issue_instr_i.fu == NONE) begin
-                issue_ack_o = 1'b1;
+            if (issue_instr_i[0].fu == NONE) begin
+                issue_ack_o[0] = 1'b1;
             end
         end
         // after a multiplication was issued we can only issue another multiplication
         // otherwise we will get contentions on the fixed latency bus
-        if (mult_valid_q && issue_instr_i.fu != MULT) begin
-            issue_ack_o = 1'b0;
+        if (mult_valid_q && issue_instr_i[0].fu != MULT) begin
+            issue_ack_o[0] = 1'b0;
         end
     end
 
     // ----------------------
     // Integer Register File
     // ----------------------
-    logic [1:0][63:0] rdata;
-    logic [1:0][4:0]  raddr_pack;
+    logic [2*ISSUE_WIDTH-1:0][63:0] rdata;
+    logic [2*ISSUE_WIDTH-1:0][4:0]  raddr_pack;
 
     // pack signals
     logic [NR_COMMIT_PORTS-1:0][4:0]  waddr_pack;
     logic [NR_COMMIT_PORTS-1:0][63:0] wdata_pack;
     logic [NR_COMMIT_PORTS-1:0]       we_pack;
-    assign raddr_pack = {issue_instr_i.rs2[4:0], issue_instr_i.rs1[4:0]};
+    // two read ports per issue lane
+    for (genvar i = 0; i < ISSUE_WIDTH; i++) begin : gen_raddr_pack
+        assign raddr_pack[2*i]   = issue_instr_i[i].rs1[4:0];
+        assign raddr_pack[2*i+1] = issue_instr_i[i].rs2[4:0];
+    end
     assign waddr_pack = {waddr_i[1],  waddr_i[0]};
     assign wdata_pack = {wdata_i[1],  wdata_i[0]};
     assign we_pack    = {we_gpr_i[1], we_gpr_i[0]};
 
     ariane_regfile #(
         .DATA_WIDTH     ( 64              ),
-        .NR_READ_PORTS  ( 2               ),
+        .NR_READ_PORTS  ( 2*ISSUE_WIDTH   ),
         .NR_WRITE_PORTS ( NR_COMMIT_PORTS ),
         .ZERO_REG_ZERO  ( 1               )
     ) i_ariane_regfile (
@@ -367,7 +374,7 @@ module issue_read_operands #(
 
     generate
         if (FP_PRESENT) begin : float_regfile_gen
-            assign fp_raddr_pack = {issue_instr_i.result[4:0], issue_instr_i.rs2[4:0], issue_instr_i.rs1[4:0]};
+            assign fp_raddr_pack = {issue_instr_i[0].result[4:0], issue_instr_i[0].rs2[4:0], issue_instr_i[0].rs1[4:0]};
             assign fp_wdata_pack = {wdata_i[1][FLEN-1:0], wdata_i[0][FLEN-1:0]};
 
             ariane_regfile #(
@@ -389,10 +396,117 @@ module issue_read_operands #(
         end
     endgenerate
 
-    assign operand_a_regfile = is_rs1_fpr(issue_instr_i.op) ? fprdata[0] : rdata[0];
-    assign operand_b_regfile = is_rs2_fpr(issue_instr_i.op) ? fprdata[1] : rdata[1];
+    assign operand_a_regfile = is_rs1_fpr(issue_instr_i[0].op) ? fprdata[0] : rdata[0];
+    assign operand_b_regfile = is_rs2_fpr(issue_instr_i[0].op) ? fprdata[1] : rdata[1];
     assign operand_c_regfile = fprdata[2];
 
+    // --------------------------
+    // Second Issue Lane (ALU 2)
+    // --------------------------
+    // The second lane issues the instruction behind the one on lane 0 in the
+    // same cycle. It only takes integer ALU instructions which go to a
+    // dedicated ALU with its own write-back port, hence they never compete for
+    // the fixed latency unit. The instruction on lane 0 is not in the
+    // scoreboard yet, so lane 1 must not depend on its result.
+    generate
+        if (ISSUE_WIDTH > 1) begin : gen_dual_issue
+            logic        stall_1;
+            logic        forward_rs1_1, forward_rs2_1;
+            logic        lane0_writes_gpr;
+            logic [63:0] operand_a_1_n, operand_b_1_n;
+            fu_data_t    alu2_fu_data_n, alu2_fu_data_q;
+            logic        alu2_valid_n,   alu2_valid_q;
+
+            assign alu2_fu_data_o = alu2_fu_data_q;
+            assign alu2_valid_o   = alu2_valid_q;
+
+            assign lane0_writes_gpr = !is_rd_fpr(issue_instr_i[0].op) && (issue_instr_i[0].rd != '0);
+
+            // check that all operands are available, otherwise stall
+            always_comb begin : operands_available_1
+                stall_1       = 1'b0;
+                forward_rs1_1 = 1'b0;
+                forward_rs2_1 = 1'b0;
+                // poll the scoreboard for those values
+                rs1_o[1] = issue_instr_i[1].rs1;
+                rs2_o[1] = issue_instr_i[1].rs2;
+
+                if (rd_clobber_gpr_i[issue_instr_i[1].rs1] != NONE) begin
+                    if (rs1_valid_i[1] && rd_clobber_gpr_i[issue_instr_i[1].rs1] != CSR)
+                        forward_rs1_1 = 1'b1;
+                    else
+                        stall_1 = 1'b1;
+                end
+
+                if (rd_clobber_gpr_i[issue_instr_i[1].rs2] != NONE) begin
+                    if (rs2_valid_i[1] && rd_clobber_gpr_i[issue_instr_i[1].rs2] != CSR)
+                        forward_rs2_1 = 1'b1;
+                    else
+                        stall_1 = 1'b1;
+                end
+
+                // RAW on the instruction issued on lane 0 in the same cycle
+                if (lane0_writes_gpr && (issue_instr_i[1].rs1 == issue_instr_i[0].rd
+                                      || issue_instr_i[1].rs2 == issue_instr_i[0].rd))
+                    stall_1 = 1'b1;
+            end
+
+            // Forwarding/Output MUX
+            always_comb begin : forwarding_operand_select_1
+                operand_a_1_n = forward_rs1_1 ? rs1_i[1] : rdata[2];
+                operand_b_1_n = forward_rs2_1 ? rs2_i[1] : rdata[3];
+                // use the PC as operand a
+                if (issue_instr_i[1].use_pc)
+                    operand_a_1_n = issue_instr_i[1].pc;
+                // or is it an immediate
+                if (issue_instr_i[1].use_imm)
+                    operand_b_1_n = issue_instr_i[1].result;
+
+                alu2_fu_data_n.fu        = ALU;
+                alu2_fu_data_n.operator  = issue_instr_i[1].op;
+                alu2_fu_data_n.operand_a = operand_a_1_n;
+                alu2_fu_data_n.operand_b = operand_b_1_n;
+                alu2_fu_data_n.imm       = issue_instr_i[1].result;
+                alu2_fu_data_n.trans_id  = issue_instr_i[1].trans_id;
+            end
+
+            always_comb begin : issue_scoreboard_1
+                issue_ack_o[1] = 1'b0;
+                // lanes issue in order. Everything behind a control flow instruction
+                // gets flushed on a mis-predict, so don't pair with a branch or jump
+                if (issue_instr_valid_i[1] && issue_ack_o[0] && issue_instr_i[0].fu != CTRL_FLOW
+                    && issue_instr_i[1].fu == ALU && !issue_instr_i[1].ex.valid && !issue_instr_i[1].bp.valid
+                    && !stall_1) begin
+                    // WAW - no issued instruction has the same destination register
+                    // or it gets committed in this cycle
+                    if (rd_clobber_gpr_i[issue_instr_i[1].rd] == NONE)
+                        issue_ack_o[1] = 1'b1;
+                    for (int unsigned i = 0; i < NR_COMMIT_PORTS; i++)
+                        if (we_gpr_i[i] && waddr_i[i] == issue_instr_i[1].rd)
+                            issue_ack_o[1] = 1'b1;
+                    // WAW on the instruction of lane 0
+                    if (lane0_writes_gpr && issue_instr_i[1].rd == issue_instr_i[0].rd)
+                        issue_ack_o[1] = 1'b0;
+                end
+            end
+
+            assign alu2_valid_n = issue_ack_o[1] && !flush_i;
+
+            always_ff @(posedge clk_i or negedge rst_ni) begin
+                if (~rst_ni) begin
+                    alu2_fu_data_q <= '0;
+                    alu2_valid_q   <= 1'b0;
+                end else begin
+                    alu2_fu_data_q <= alu2_fu_data_n;
+                    alu2_valid_q   <= alu2_valid_n;
+                end
+            end
+        end else begin : gen_single_issue
+            assign alu2_fu_data_o = '0;
+            assign alu2_valid_o   = 1'b0;
+        end
+    endgenerate
+
     // ----------------------
     // Registers (ID <-> EX)
     // ----------------------
@@ -430,9 +544,9 @@ module issue_read_operands #(
             fu_q                  <= fu_n;
             operator_q            <= operator_n;
             trans_id_q            <= trans_id_n;
-            pc_o                  <= issue_instr_i.pc;
-            is_compressed_instr_o <= issue_instr_i.is_compressed;
-            branch_predict_o      <= issue_instr_i.bp;
+            pc_o                  <= issue_instr_i[0].pc;
+            is_compressed_instr_o <= issue_instr_i[0].is_compressed;
+            branch_predict_o      <= issue_instr_i[0].bp;
         end
     end
 
@@ -24,19 +24,23 @@ module issue_stage #(
     input  logic                                     rst_ni,    // Asynchronous reset active low
 
     output logic                                     sb_full_o,
+    output logic [$clog2(NR_ENTRIES)-1:0]            sb_occupancy_o,
     input  logic                                     flush_unissued_instr_i,
     input  logic                                     flush_i,
     // from ISSUE
-    input  scoreboard_entry_t                        decoded_instr_i,
-    input  logic                                     decoded_instr_valid_i,
+    input  scoreboard_entry_t [ISSUE_WIDTH-1:0]      decoded_instr_i,
+    input  logic [ISSUE_WIDTH-1:0]                   decoded_instr_valid_i,
     input  logic                                     is_ctrl_flow_i,
-    output logic                                     decoded_instr_ack_o,
+    output logic [ISSUE_WIDTH-1:0]                   decoded_instr_ack_o,
     // to EX
     output fu_data_t                                 fu_data_o,
     output logic [63:0]                              pc_o,
     output logic                                     is_compressed_instr_o,
     input  logic                                     flu_ready_i,
     output logic                                     alu_valid_o,
+    // ALU of the second issue lane
+    output fu_data_t                                 alu2_fu_data_o,
+    output logic                                     alu2_valid_o,
     // ex just resolved our predicted branch, we are ready to accept new requests
     input  logic                                     resolve_branch_i,
 
@@ -77,42 +81,49 @@ module issue_stage #(
     fu_t  [2**REG_ADDR_SIZE:0] rd_clobber_gpr_sb_iro;
     fu_t  [2**REG_ADDR_SIZE:0] rd_clobber_fpr_sb_iro;
 
-    logic [REG_ADDR_SIZE-1:0]  rs1_iro_sb;
-    logic [63:0]               rs1_sb_iro;
-    logic                      rs1_valid_sb_iro;
+    logic [ISSUE_WIDTH-1:0][REG_ADDR_SIZE-1:0] rs1_iro_sb;
+    logic [ISSUE_WIDTH-1:0][63:0]              rs1_sb_iro;
+    logic [ISSUE_WIDTH-1:0]                    rs1_valid_sb_iro;
 
-    logic [REG_ADDR_SIZE-1:0]  rs2_iro_sb;
-    logic [63:0]               rs2_sb_iro;
-    logic                      rs2_valid_iro_sb;
+    logic [ISSUE_WIDTH-1:0][REG_ADDR_SIZE-1:0] rs2_iro_sb;
+    logic [ISSUE_WIDTH-1:0][63:0]              rs2_sb_iro;
+    logic [ISSUE_WIDTH-1:0]                    rs2_valid_iro_sb;
 
     logic [REG_ADDR_SIZE-1:0]  rs3_iro_sb;
     logic [FLEN-1:0]           rs3_sb_iro;
     logic                      rs3_valid_iro_sb;
 
-    scoreboard_entry_t         issue_instr_rename_sb;
-    logic                      issue_instr_valid_rename_sb;
-    logic                      issue_ack_sb_rename;
+    scoreboard_entry_t [ISSUE_WIDTH-1:0] issue_instr_rename_sb;
+    logic [ISSUE_WIDTH-1:0]              issue_instr_valid_rename_sb;
+    logic [ISSUE_WIDTH-1:0]              issue_ack_sb_rename;
 
-    scoreboard_entry_t         issue_instr_sb_iro;
-    logic                      issue_instr_valid_sb_iro;
-    logic                      issue_ack_iro_sb;
+    scoreboard_entry_t [ISSUE_WIDTH-1:0] issue_instr_sb_iro;
+    logic [ISSUE_WIDTH-1:0]              issue_instr_valid_sb_iro;
+    logic [ISSUE_WIDTH-1:0]              issue_ack_iro_sb;
 
     // ---------------------------------------------------------
     // 1. Re-name
     // ---------------------------------------------------------
     re_name i_re_name (
-        .clk_i                  ( clk_i                        ),
-        .rst_ni                 ( rst_ni                       ),
-        .flush_i                ( flush_i                      ),
-        .flush_unissied_instr_i ( flush_unissued_instr_i       ),
-        .issue_instr_i          ( decoded_instr_i              ),
-        .issue_instr_valid_i    ( decoded_instr_valid_i        ),
-        .issue_ack_o            ( decoded_instr_ack_o          ),
-        .issue_instr_o          ( issue_instr_rename_sb        ),
-        .issue_instr_valid_o    ( issue_instr_valid_rename_sb  ),
-        .issue_ack_i            ( issue_ack_sb_rename          )
+        .clk_i                  ( clk_i                          ),
+        .rst_ni                 ( rst_ni                         ),
+        .flush_i                ( flush_i                        ),
+        .flush_unissied_instr_i ( flush_unissued_instr_i         ),
+        .issue_instr_i          ( decoded_instr_i[0]             ),
+        .issue_instr_valid_i    ( decoded_instr_valid_i[0]       ),
+        .issue_ack_o            ( decoded_instr_ack_o[0]         ),
+        .issue_instr_o          ( issue_instr_rename_sb[0]       ),
+        .issue_instr_valid_o    ( issue_instr_valid_rename_sb[0] ),
+        .issue_ack_i            ( issue_ack_sb_rename[0]         )
     );
 
+    // re-naming is only supported with a single issue lane, the other lanes bypass it
+    for (genvar i = 1; i < ISSUE_WIDTH; i++) begin : gen_no_re_name
+        assign issue_instr_rename_sb[i]       = decoded_instr_i[i];
+        assign issue_instr_valid_rename_sb[i] = decoded_instr_valid_i[i];
+        assign decoded_instr_ack_o[i]         = issue_ack_sb_rename[i];
+    end
+
     // ---------------------------------------------------------
     // 2. Manage instructions in a scoreboard
     // ---------------------------------------------------------
@@ -173,7 +184,18 @@ module issue_stage #(
         .branch_valid_o      ( branch_valid_o                  ),
         .csr_valid_o         ( csr_valid_o                     ),
         .mult_valid_o        ( mult_valid_o                    ),
+        .alu2_fu_data_o      ( alu2_fu_data_o                  ),
+        .alu2_valid_o        ( alu2_valid_o                    ),
         .*
     );
 
+    //pragma translate_off
+    `ifndef VERILATOR
+    initial begin
+        assert (ISSUE_WIDTH == 1 || ISSUE_WIDTH == 2) else $fatal(1, "[issue_stage] Only one or two issue lanes are supported");
+        assert (ISSUE_WIDTH == 1 || !ENABLE_RENAME) else $fatal(1, "[issue_stage] Re-naming is not supported with dual issue");
+    end
+    `endif
+    //pragma translate_on
+
 endmodule
@@ -15,7 +15,8 @@
 import ariane_pkg::*;
 
 module load_store_unit #(
-    parameter int unsigned ASID_WIDTH = 1
+    parameter int unsigned ASID_WIDTH       = 1,
+    parameter logic [63:0] CACHE_START_ADDR = 64'h8000_0000
 )(
     input  logic                     clk_i,
     input  logic                     rst_ni,
@@ -24,6 +25,7 @@ module load_store_unit #(
     input  logic                     amo_valid_commit_i,
 
     input  fu_data_t                 fu_data_i,
+    input  logic [63:0]              pc_i,                     // PC of the load/store, for the D$ prefetcher
     output logic                     lsu_ready_o,              // FU is ready e.g. not busy
     input  logic                     lsu_valid_i,              // Input is valid
 
@@ -57,10 +59,14 @@ module load_store_unit #(
     // Performance counters
     output logic                     itlb_miss_o,
     output logic                     dtlb_miss_o,
+    output logic                     ld_forward_o,
+    output logic                     ld_stall_o,
+    // D$ prefetcher training
+    output dcache_train_t            dcache_train_o,
 
     // interface to dcache
-    input  dcache_req_o_t [2:0]      dcache_req_ports_i,
-    output dcache_req_i_t [2:0]      dcache_req_ports_o,
+    input  dcache_req_o_t [NR_DCACHE_PORTS-1:0] dcache_req_ports_i,
+    output dcache_req_i_t [NR_DCACHE_PORTS-1:0] dcache_req_ports_o,
     // AMO interface
     output amo_req_t                 amo_req_o,
     input  amo_resp_t                amo_resp_i
@@ -108,6 +114,8 @@ module load_store_unit #(
 
     logic [11:0]              page_offset;
     logic                     page_offset_matches;
+    logic [63:0]              fwd_data;
+    logic [7:0]               fwd_be;
 
     exception_t               misaligned_exception;
     exception_t               ld_ex;
@@ -167,18 +175,24 @@ module load_store_unit #(
         // Load Unit
         .page_offset_i         ( page_offset          ),
         .page_offset_matches_o ( page_offset_matches  ),
+        .fwd_paddr_i           ( mmu_paddr            ),
+        .fwd_data_o            ( fwd_data             ),
+        .fwd_be_o              ( fwd_be               ),
         // AMOs
         .amo_req_o,
         .amo_resp_i,
         // to memory arbiter
-        .req_port_i             ( dcache_req_ports_i [2] ),
-        .req_port_o             ( dcache_req_ports_o [2] )
+        .req_port_i             ( dcache_req_ports_i [NR_DCACHE_PORTS-1] ),
+        .req_port_o             ( dcache_req_ports_o [NR_DCACHE_PORTS-1] )
     );
 
     // ------------------
     // Load Unit
     // ------------------
-    load_unit i_load_unit (
+    load_unit #(
+        .NR_PORTS              ( NR_LOAD_PORTS        ),
+        .CACHE_START_ADDR      ( CACHE_START_ADDR     )
+    ) i_load_unit (
         .valid_i               ( ld_valid_i           ),
         .lsu_ctrl_i            ( lsu_ctrl             ),
         .pop_ld_o              ( pop_ld               ),
@@ -196,9 +210,14 @@ module load_store_unit #(
         // to store unit
         .page_offset_o         ( page_offset          ),
         .page_offset_matches_i ( page_offset_matches  ),
+        .fwd_data_i            ( fwd_data             ),
+        .fwd_be_i              ( fwd_be               ),
+        .ld_forward_o,
+        .ld_stall_o,
+        .train_o               ( dcache_train_o       ),
         // to memory arbiter
-        .req_port_i            ( dcache_req_ports_i [1] ),
-        .req_port_o            ( dcache_req_ports_o [1] ),
+        .req_port_i            ( dcache_req_ports_i [NR_LOAD_PORTS:1] ),
+        .req_port_o            ( dcache_req_ports_o [NR_LOAD_PORTS:1] ),
         .*
     );
 
@@ -355,7 +374,7 @@ module load_store_unit #(
     // new data arrives here
     lsu_ctrl_t lsu_req_i;
 
-    assign lsu_req_i = {lsu_valid_i, vaddr_i, fu_data_i.operand_b, be_i, fu_data_i.fu, fu_data_i.operator, fu_data_i.trans_id};
+    assign lsu_req_i = {lsu_valid_i, vaddr_i, pc_i, fu_data_i.operand_b, be_i, fu_data_i.fu, fu_data_i.operator, fu_data_i.trans_id};
 
     lsu_bypass lsu_bypass_i (
         .lsu_req_i          ( lsu_req_i   ),
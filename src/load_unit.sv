@@ -15,7 +15,10 @@
 
 import ariane_pkg::*;
 
-module load_unit (
+module load_unit #(
+    parameter int unsigned NR_PORTS         = 1,
+    parameter logic [63:0] CACHE_START_ADDR = 64'h8000_0000 // everything below is not cached (e.g. I/O)
+)(
     input  logic                     clk_i,    // Clock
     input  logic                     rst_ni,   // Asynchronous reset active low
     input  logic                     flush_i,
@@ -37,39 +40,139 @@ module load_unit (
     // address checker
     output logic [11:0]              page_offset_o,
     input  logic                     page_offset_matches_i,
+    // store buffer forwarding, valid for the load in lsu_ctrl_i in the cycle after its translation
+    input  logic [63:0]              fwd_data_i,
+    input  logic [7:0]               fwd_be_i,            // bytes which have been found in the store buffer
+    // performance counters
+    output logic                     ld_forward_o,        // load got data from the store buffer
+    output logic                     ld_stall_o,          // load waits for the store buffer to drain
+    // D$ prefetcher, loads which have sent their tag
+    output dcache_train_t            train_o,
     // D$ interface
-    input dcache_req_o_t             req_port_i,
-    output dcache_req_i_t            req_port_o
+    input  dcache_req_o_t [NR_PORTS-1:0] req_port_i,
+    output dcache_req_i_t [NR_PORTS-1:0] req_port_o
 );
+    // The load unit can have one request outstanding on each of its D$ ports. Requests are sent
+    // one at a time by the FSM below, but as soon as the tag has been sent the FSM continues with
+    // the next load on a free port. A miss on one port therefore doesn't block hits (or misses,
+    // if the cache can serve them) on the other ports. Each port remembers the transaction ID of
+    // its load, the responses can come back out-of-order and are written back by transaction ID.
+    //
+    // A load whose page offset matches a store in the store buffer used to wait until the buffer had
+    // been drained. It now sends its request anyway but stays in lsu_ctrl_i until the physical address
+    // is known (FWD_TAG). The store buffer then returns the bytes of all stores to the same double word,
+    // the youngest store wins. They are merged into the data returned by the cache, or the request is
+    // killed and answered right away if they cover the whole load. Only loads to non-cached memory
+    // still wait for the store buffer to drain, as the device has to see the load.
+    localparam PORT_BITS = (NR_PORTS > 1) ? $clog2(NR_PORTS) : 1;
+
     enum logic [2:0] { IDLE, WAIT_GNT, SEND_TAG, WAIT_PAGE_OFFSET,
-                       ABORT_TRANSACTION, WAIT_TRANSLATION, WAIT_FLUSH
+                       ABORT_TRANSACTION, WAIT_TRANSLATION, WAIT_FLUSH, FWD_TAG
                      } state_d, state_q;
-    // in order to decouple the response interface from the request interface we need a
-    // a queue which can hold all outstanding memory requests
-    struct packed {
+    // in order to decouple the response interface from the request interface we need to
+    // remember the load which is outstanding on each port
+    typedef struct packed {
         logic [TRANS_ID_BITS-1:0] trans_id;
         logic [2:0]               address_offset;
         fu_op                     operator;
-    } load_data_d, load_data_q, in_data;
+        // prepare the sign extension for faster selection on the response
+        logic [2:0]               sign_idx;
+        logic                     sign_ext;
+        logic                     fp_sign;
+        // data forwarded from the store buffer, replaces the bytes returned by the cache
+        logic [7:0]               fwd_be;
+        logic [63:0]              fwd_data;
+    } load_data_t;
+
+    load_data_t [NR_PORTS-1:0]       load_data_d, load_data_q;
+    load_data_t                      in_data;
+    // a request has been sent on the port and the response did not come back yet
+    logic [NR_PORTS-1:0]             outstanding_d, outstanding_q;
+    // responses which arrived while the output was busy with another one
+    logic [NR_PORTS-1:0]             resp_valid_d, resp_valid_q;
+    load_data_t [NR_PORTS-1:0]       resp_data_d, resp_data_q;
+    logic [NR_PORTS-1:0][63:0]       resp_rdata_d, resp_rdata_q;
+    // port of the request which is currently in the grant or tag phase
+    logic [PORT_BITS-1:0]            port_d, port_q;
+    // port the next request goes to
+    logic [PORT_BITS-1:0]            port_sel;
+    // request control, the FSM below drives a single request which gets steered to port_sel
+    // (data request) and port_q (tag phase)
+    logic                            data_req, data_gnt, tag_valid, kill_req;
+    // the exception of the load in lsu_ctrl_i is retired this cycle
+    logic                            ex_retire;
+    // forwarding decision in FWD_TAG
+    logic [7:0]                      fwd_be;
+    logic                            fwd_full, fwd_stall, fwd_kill;
+    // PC of the load in the tag phase, it has already left lsu_ctrl_i in SEND_TAG
+    logic [63:0]                     pc_d, pc_q;
 
     // page offset is defined as the lower 12 bits, feed through for address checker
     assign page_offset_o = lsu_ctrl_i.vaddr[11:0];
     // feed-through the virtual address for VA translation
     assign vaddr_o = lsu_ctrl_i.vaddr;
-    // this is a read-only interface so set the write enable to 0
-    assign req_port_o.data_we = 1'b0;
-    assign req_port_o.data_wdata = '0;
-    // compose the queue data, control is handled in the FSM
-    assign in_data = {lsu_ctrl_i.trans_id, lsu_ctrl_i.vaddr[2:0], lsu_ctrl_i.operator};
-    // output address
-    // we can now output the lower 12 bit as the index to the cache
-    assign req_port_o.address_index = lsu_ctrl_i.vaddr[ariane_pkg::DCACHE_INDEX_WIDTH-1:0];
-    // translation from last cycle, again: control is handled in the FSM
-    assign req_port_o.address_tag   = paddr_i[ariane_pkg::DCACHE_TAG_WIDTH     +
-                                              ariane_pkg::DCACHE_INDEX_WIDTH-1 :
-                                              ariane_pkg::DCACHE_INDEX_WIDTH];
-    // directly output an exception
-    assign ex_o = ex_i;
+    // compose the load data, control is handled in the FSM
+    assign in_data.trans_id       = lsu_ctrl_i.trans_id;
+    assign in_data.address_offset = lsu_ctrl_i.vaddr[2:0];
+    assign in_data.operator       = lsu_ctrl_i.operator;
+    assign in_data.sign_idx       = (lsu_ctrl_i.operator inside {LW, FLW}) ? lsu_ctrl_i.vaddr[2:0] + 3 :
+                                    (lsu_ctrl_i.operator inside {LH, FLH}) ? lsu_ctrl_i.vaddr[2:0] + 1 :
+                                                                             lsu_ctrl_i.vaddr[2:0];
+    assign in_data.sign_ext       = lsu_ctrl_i.operator inside {LW, LH, LB};
+    assign in_data.fp_sign        = lsu_ctrl_i.operator inside {FLW, FLH, FLB};
+    assign in_data.fwd_be         = '0;
+    assign in_data.fwd_data       = '0;
+
+    // ---------------
+    // Forwarding
+    // ---------------
+    // the load is still in lsu_ctrl_i while in FWD_TAG
+    assign fwd_be    = fwd_be_i & lsu_ctrl_i.be;
+    // all bytes of the load are in the store buffer, we do not need the cache
+    assign fwd_full  = fwd_be == lsu_ctrl_i.be;
+    // the device needs to see the load after the store
+    assign fwd_stall = state_q == FWD_TAG && !ex_i.valid && page_offset_matches_i
+                    && paddr_i < CACHE_START_ADDR;
+    // ---------------
+    // Port Selection
+    // ---------------
+    // take the first port which neither has a request outstanding nor a response waiting, if all
+    // of them are busy queue up behind the port after the one used last, it is the oldest one in
+    // most cases. With a single port this is always port 0.
+    always_comb begin : select_port
+        port_sel = (port_q == NR_PORTS-1) ? '0 : port_q + 1;
+        for (int i = NR_PORTS-1; i >= 0; i--) begin
+            if (!outstanding_q[i] && !resp_valid_q[i])
+                port_sel = i;
+        end
+    end
+
+    // a waiting response would get overwritten by the one of the new request
+    assign data_gnt = req_port_i[port_sel].data_gnt && !resp_valid_q[port_sel];
+
+    for (genvar i = 0; i < NR_PORTS; i++) begin : gen_req_port
+        // this is a read-only interface so set the write enable to 0
+        assign req_port_o[i].data_we    = 1'b0;
+        assign req_port_o[i].data_wdata = '0;
+        assign req_port_o[i].data_be    = lsu_ctrl_i.be;
+        assign req_port_o[i].data_size  = extract_transfer_size(lsu_ctrl_i.operator);
+        // output address
+        // we can now output the lower 12 bit as the index to the cache
+        assign req_port_o[i].address_index = lsu_ctrl_i.vaddr[ariane_pkg::DCACHE_INDEX_WIDTH-1:0];
+        // translation from last cycle, again: control is handled in the FSM
+        assign req_port_o[i].address_tag   = paddr_i[ariane_pkg::DCACHE_TAG_WIDTH     +
+                                                     ariane_pkg::DCACHE_INDEX_WIDTH-1 :
+                                                     ariane_pkg::DCACHE_INDEX_WIDTH];
+        assign req_port_o[i].data_req  = data_req && port_sel == i && !resp_valid_q[i];
+        // on a flush all outstanding requests are killed
+        assign req_port_o[i].tag_valid = tag_valid && (port_q == i || state_q == WAIT_FLUSH);
+        assign req_port_o[i].kill_req  = (kill_req || fwd_kill) && (port_q == i || state_q == WAIT_FLUSH);
+    end
+
+    // every load which really goes to the cache trains the prefetcher, including the forwarded ones
+    assign train_o.valid = tag_valid && !kill_req;
+    assign train_o.pc    = pc_q;
+    assign train_o.paddr = paddr_i[55:0];
 
     // ---------------
     // Load Control
@@ -77,15 +180,18 @@ module load_unit (
     always_comb begin : load_control
         // default assignments
         state_d              = state_q;
+        port_d               = port_q;
         load_data_d          = load_data_q;
+        pc_d                 = pc_q;
         translation_req_o    = 1'b0;
-        req_port_o.data_req  = 1'b0;
+        data_req             = 1'b0;
         // tag control
-        req_port_o.kill_req  = 1'b0;
-        req_port_o.tag_valid = 1'b0;
-        req_port_o.data_be   = lsu_ctrl_i.be;
-        req_port_o.data_size = extract_transfer_size(lsu_ctrl_i.operator);
+        kill_req             = 1'b0;
+        tag_valid            = 1'b0;
+        fwd_kill             = 1'b0;
         pop_ld_o             = 1'b0;
+        ld_forward_o         = 1'b0;
+        ld_stall_o           = 1'b0;
 
         case (state_q)
             IDLE: begin
@@ -94,24 +200,24 @@ module load_unit (
                     // start the translation process even though we do not know if the addresses match
                     // this should ease timing
                     translation_req_o = 1'b1;
-                    // check if the page offset matches with a store, if it does then stall and wait
-                    if (!page_offset_matches_i) begin
-                        // make a load request to memory
-                        req_port_o.data_req = 1'b1;
-                        // we got no data grant so wait for the grant before sending the tag
-                        if (!req_port_i.data_gnt) begin
-                            state_d = WAIT_GNT;
-                        end else begin
-                            if (dtlb_hit_i) begin
-                                // we got a grant and a hit on the DTLB so we can send the tag in the next cycle
-                                state_d = SEND_TAG;
-                                pop_ld_o = 1'b1;
-                            end else
-                                state_d = ABORT_TRANSACTION;
-                        end
+                    // make a load request to memory
+                    data_req = 1'b1;
+                    // we got no data grant so wait for the grant before sending the tag
+                    if (!data_gnt) begin
+                        state_d = WAIT_GNT;
                     end else begin
-                        // wait for the store buffer to train and the page offset to not match anymore
-                        state_d = WAIT_PAGE_OFFSET;
+                        if (dtlb_hit_i) begin
+                            // we got a grant and a hit on the DTLB so we can send the tag in the next cycle
+                            state_d = SEND_TAG;
+                            pop_ld_o = 1'b1;
+                            // check if the page offset matches with a store, if it does look for the data in
+                            // the store buffer once we know the physical address
+                            if (page_offset_matches_i) begin
+                                state_d = FWD_TAG;
+                                pop_ld_o = 1'b0;
+                            end
+                        end else
+                            state_d = ABORT_TRANSACTION;
                     end
                 end
             end
@@ -128,8 +234,8 @@ module load_unit (
             // we are here because of a TLB miss, we need to abort the current request and give way for the
             // PTW walker to satisfy the TLB miss
             ABORT_TRANSACTION: begin
-                req_port_o.kill_req  = 1'b1;
-                req_port_o.tag_valid = 1'b1;
+                kill_req  = 1'b1;
+                tag_valid = 1'b1;
                 // redo the request by going back to the wait gnt state
                 state_d = WAIT_TRANSLATION;
             end
@@ -145,13 +251,18 @@ module load_unit (
                 // keep the translation request up
                 translation_req_o = 1'b1;
                 // keep the request up
-                req_port_o.data_req = 1'b1;
+                data_req = 1'b1;
                 // we finally got a data grant
-                if (req_port_i.data_gnt) begin
+                if (data_gnt) begin
                     // so we send the tag in the next cycle
                     if (dtlb_hit_i) begin
                         state_d = SEND_TAG;
                         pop_ld_o = 1'b1;
+                        // the page offset matches with a store, check the store buffer first
+                        if (page_offset_matches_i) begin
+                            state_d = FWD_TAG;
+                            pop_ld_o = 1'b0;
+                        end
                     end else // should we not have hit on the TLB abort this transaction an retry later
                         state_d = ABORT_TRANSACTION;
                 end
@@ -159,32 +270,31 @@ module load_unit (
             end
             // we know for sure that the tag we want to send is valid
             SEND_TAG: begin
-                req_port_o.tag_valid = 1'b1;
+                tag_valid = 1'b1;
                 state_d = IDLE;
                 // we can make a new request here if we got one
                 if (valid_i) begin
                     // start the translation process even though we do not know if the addresses match
                     // this should ease timing
                     translation_req_o = 1'b1;
-                    // check if the page offset matches with a store, if it does stall and wait
-                    if (!page_offset_matches_i) begin
-                        // make a load request to memory
-                        req_port_o.data_req = 1'b1;
-                        // we got no data grant so wait for the grant before sending the tag
-                        if (!req_port_i.data_gnt) begin
-                            state_d = WAIT_GNT;
-                        end else begin
-                            // we got a grant so we can send the tag in the next cycle
-                            if (dtlb_hit_i) begin
-                                // we got a grant and a hit on the DTLB so we can send the tag in the next cycle
-                                state_d = SEND_TAG;
-                                pop_ld_o = 1'b1;
-                            end else // we missed on the TLB -> wait for the translation
-                                state_d = ABORT_TRANSACTION;
-                        end
+                    // make a load request to memory
+                    data_req = 1'b1;
+                    // we got no data grant so wait for the grant before sending the tag
+                    if (!data_gnt) begin
+                        state_d = WAIT_GNT;
                     end else begin
-                        // wait for the store buffer to train and the page offset to not match anymore
-                        state_d = WAIT_PAGE_OFFSET;
+                        // we got a grant so we can send the tag in the next cycle
+                        if (dtlb_hit_i) begin
+                            // we got a grant and a hit on the DTLB so we can send the tag in the next cycle
+                            state_d = SEND_TAG;
+                            pop_ld_o = 1'b1;
+                            // the page offset matches with a store, check the store buffer first
+                            if (page_offset_matches_i) begin
+                                state_d = FWD_TAG;
+                                pop_ld_o = 1'b0;
+                            end
+                        end else // we missed on the TLB -> wait for the translation
+                            state_d = ABORT_TRANSACTION;
                     end
                 end
                 // ----------
@@ -192,33 +302,68 @@ module load_unit (
                 // ----------
                 // if we got an exception we need to kill the request immediately
                 if (ex_i.valid) begin
-                    req_port_o.kill_req = 1'b1;
+                    kill_req = 1'b1;
+                end
+            end
+
+            // we know the physical address now, take the data from the store buffer
+            FWD_TAG: begin
+                tag_valid = 1'b1;
+                state_d = IDLE;
+                // an exception gets retired with the response to the killed request, as for SEND_TAG
+                if (ex_i.valid) begin
+                    kill_req = 1'b1;
+                    pop_ld_o = 1'b1;
+                // wait for the store buffer to drain and try again
+                end else if (fwd_stall) begin
+                    kill_req   = 1'b1;
+                    ld_stall_o = 1'b1;
+                    state_d    = WAIT_PAGE_OFFSET;
+                end else begin
+                    pop_ld_o     = 1'b1;
+                    ld_forward_o = |fwd_be;
+                    // the response of the killed request is the forwarded data
+                    fwd_kill     = fwd_full;
+                    load_data_d[port_q].fwd_be   = fwd_be;
+                    load_data_d[port_q].fwd_data = fwd_data_i;
                 end
             end
 
             WAIT_FLUSH: begin
                 // the D$ arbiter will take care of presenting this to the memory only in case we
                 // have an outstanding request
-                req_port_o.kill_req  = 1'b1;
-                req_port_o.tag_valid = 1'b1;
+                kill_req  = 1'b1;
+                tag_valid = 1'b1;
                 // we've killed the current request so we can go back to idle
                 state_d = IDLE;
             end
 
         endcase
 
+        // remember the port we've got the grant on for the tag phase
+        if (data_req && data_gnt) begin
+            port_d = port_sel;
+        end
+
         // we got an exception
         if (ex_i.valid && valid_i) begin
             // the next state will be the idle state
             state_d = IDLE;
-            // pop load - but only if we are not getting an rvalid in here - otherwise we will over-write an incoming transaction
-            if (!req_port_i.data_rvalid)
-                pop_ld_o = 1'b1;
+            // pop load - but only if the exception is retired this cycle - otherwise an incoming
+            // response has precedence and we go for another round
+            pop_ld_o = ex_retire || state_q == FWD_TAG;
+        end
+
+        // do not start a new request with an exception pending, the grant would leave the port
+        // waiting for a tag which we are never going to send
+        if (ex_i.valid) begin
+            data_req = 1'b0;
         end
 
-        // save the load data for later usage -> we should not clutter the load_data register
-        if (pop_ld_o && !ex_i.valid) begin
-            load_data_d = in_data;
+        // save the load data for later usage
+        if (state_d inside {SEND_TAG, FWD_TAG}) begin
+            load_data_d[port_d] = in_data;
+            pc_d                = lsu_ctrl_i.pc;
         end
 
         // if we just flushed and the queue is not empty or we are getting an rvalid this cycle wait in a extra stage
@@ -230,59 +375,143 @@ module load_unit (
     // ---------------
     // Retire Load
     // ---------------
+    logic [NR_PORTS-1:0] rvalid;
+    load_data_t          out_data;
+    logic [63:0]         out_rdata;
+
+    // we got an rvalid for a request we are waiting for and are currently not flushing, aborted
+    // requests are not outstanding
+    for (genvar i = 0; i < NR_PORTS; i++) begin : gen_rvalid
+        assign rvalid[i] = req_port_i[i].data_rvalid && outstanding_q[i] && state_q != WAIT_FLUSH;
+    end
+
     // decoupled rvalid process
     always_comb begin : rvalid_output
-        valid_o = 1'b0;
-        // output the queue data directly, the valid signal is set corresponding to the process above
-        trans_id_o = load_data_q.trans_id;
-        // we got an rvalid and are currently not flushing and not aborting the request
-        if (req_port_i.data_rvalid && state_q != WAIT_FLUSH) begin
-            // we killed the request
-            if(!req_port_o.kill_req)
-                valid_o = 1'b1;
-            // the output is also valid if we got an exception
-            if (ex_i.valid)
-                valid_o = 1'b1;
+        automatic logic taken;
+
+        valid_o      = 1'b0;
+        // directly output an exception
+        ex_o         = ex_i;
+        ex_retire    = 1'b0;
+        taken        = 1'b0;
+        resp_valid_d = resp_valid_q;
+        resp_data_d  = resp_data_q;
+        resp_rdata_d = resp_rdata_q;
+        out_data     = load_data_q[port_q];
+        out_rdata    = req_port_i[port_q].data_rdata;
+        // the forwarded data gets saved at the end of this cycle
+        if (state_q == FWD_TAG) begin
+            out_data.fwd_be   = fwd_be;
+            out_data.fwd_data = fwd_data_i;
         end
+
+        // 1. the load in the tag phase, this is the only one which can have an exception (in that
+        //    case the request got killed), unless it has to wait for the store buffer
+        if ((state_q == SEND_TAG || (state_q == FWD_TAG && !fwd_stall)) && rvalid[port_q]) begin
+            taken = 1'b1;
+        end
+        // 2. responses which had to wait, they are older than the ones arriving now
+        for (int unsigned i = 0; i < NR_PORTS; i++) begin
+            if (resp_valid_q[i] && !taken) begin
+                taken           = 1'b1;
+                ex_o.valid      = 1'b0;
+                resp_valid_d[i] = 1'b0;
+                out_data        = resp_data_q[i];
+                out_rdata       = resp_rdata_q[i];
+            end
+        end
+        // 3. responses arriving now, park them if the output is already taken
+        for (int unsigned i = 0; i < NR_PORTS; i++) begin
+            if (rvalid[i] && !(state_q inside {SEND_TAG, FWD_TAG} && port_q == i)) begin
+                if (!taken) begin
+                    taken      = 1'b1;
+                    // the exception belongs to another load
+                    ex_o.valid = 1'b0;
+                    out_data   = load_data_q[i];
+                    out_rdata  = req_port_i[i].data_rdata;
+                end else begin
+                    resp_valid_d[i] = 1'b1;
+                    resp_data_d[i]  = load_data_q[i];
+                    resp_rdata_d[i] = req_port_i[i].data_rdata;
+                end
+            end
+        end
+
+        valid_o    = taken;
+        trans_id_o = out_data.trans_id;
         // an exception occurred during translation (we need to check for the valid flag because we could also get an
         // exception from the store unit)
         // exceptions can retire out-of-order -> but we need to give priority to non-excepting load and stores
-        // so we simply check if we got an rvalid if so we prioritize it by not retiring the exception - we simply go for another
-        // round in the load FSM
-        if (valid_i && ex_i.valid && !req_port_i.data_rvalid) begin
+        // so we simply check if we got a response if so we prioritize it by not retiring the exception - we simply go
+        // for another round in the load FSM
+        if (valid_i && ex_i.valid && !taken) begin
             valid_o    = 1'b1;
+            ex_retire  = 1'b1;
             trans_id_o = lsu_ctrl_i.trans_id;
-        // if we are waiting for the translation to finish do not give a valid signal yet
-        end else if (state_q == WAIT_TRANSLATION) begin
-            valid_o = 1'b0;
         end
 
+        // the responses belong to speculative loads which are gone now
+        if (flush_i) begin
+            resp_valid_d = '0;
+        end
     end
 
+    // a port is busy from the grant until the response comes back
+    always_comb begin : outstanding_requests
+        outstanding_d = outstanding_q;
+
+        for (int unsigned i = 0; i < NR_PORTS; i++) begin
+            if (req_port_i[i].data_rvalid)
+                outstanding_d[i] = 1'b0;
+        end
+
+        if (state_d inside {SEND_TAG, FWD_TAG})
+            outstanding_d[port_d] = 1'b1;
+
+        if (flush_i)
+            outstanding_d = '0;
+    end
 
     // latch physical address for the tag cycle (one cycle after applying the index)
     always_ff @(posedge clk_i or negedge rst_ni) begin
         if (~rst_ni) begin
-            state_q     <= IDLE;
-            load_data_q <= '0;
+            state_q       <= IDLE;
+            port_q        <= '0;
+            load_data_q   <= '0;
+            pc_q          <= '0;
+            outstanding_q <= '0;
+            resp_valid_q  <= '0;
+            resp_data_q   <= '0;
+            resp_rdata_q  <= '0;
         end else begin
-            state_q     <= state_d;
-            load_data_q <= load_data_d;
+            state_q       <= state_d;
+            port_q        <= port_d;
+            load_data_q   <= load_data_d;
+            pc_q          <= pc_d;
+            outstanding_q <= outstanding_d;
+            resp_valid_q  <= resp_valid_d;
+            resp_data_q   <= resp_data_d;
+            resp_rdata_q  <= resp_rdata_d;
         end
     end
 
     // ---------------
     // Sign Extend
     // ---------------
-    logic [63:0] shifted_data;
+    logic [63:0] rdata, shifted_data;
+
+    // bytes found in the store buffer replace the ones from the cache
+    for (genvar i = 0; i < 8; i++) begin : gen_fwd_merge
+        assign rdata[i*8 +: 8] = out_data.fwd_be[i] ? out_data.fwd_data[i*8 +: 8] : out_rdata[i*8 +: 8];
+    end
 
     // realign as needed
-    assign shifted_data   = req_port_i.data_rdata >> {load_data_q.address_offset, 3'b000};
+    assign shifted_data   = rdata >> {out_data.address_offset, 3'b000};
 
 /*  // result mux (leaner code, but more logic stages.
     // can be used instead of the code below (in between //result mux fast) if timing is not so critical)
     always_comb begin
-        unique case (load_data_q.operator)
+        unique case (out_data.operator)
             LWU:        result_o = shifted_data[31:0];
             LHU:        result_o = shifted_data[15:0];
             LBU:        result_o = shifted_data[7:0];
@@ -295,52 +524,30 @@ module load_unit (
 
     // result mux fast
     logic [7:0]  sign_bits;
-    logic [2:0]  idx_d, idx_q;
-    logic        sign_bit, signed_d, signed_q, fp_sign_d, fp_sign_q;
-
-
-    // prepare these signals for faster selection in the next cycle
-    assign signed_d  = load_data_d.operator inside {LW, LH, LB};
-    assign fp_sign_d = load_data_d.operator inside {FLW, FLH, FLB};
-    assign idx_d     = (load_data_d.operator inside {LW, FLW}) ? load_data_d.address_offset + 3 :
-                       (load_data_d.operator inside {LH, FLH}) ? load_data_d.address_offset + 1 :
-                                                                 load_data_d.address_offset;
+    logic        sign_bit;
 
-
-    assign sign_bits = { req_port_i.data_rdata[63],
-                         req_port_i.data_rdata[55],
-                         req_port_i.data_rdata[47],
-                         req_port_i.data_rdata[39],
-                         req_port_i.data_rdata[31],
-                         req_port_i.data_rdata[23],
-                         req_port_i.data_rdata[15],
-                         req_port_i.data_rdata[7]  };
+    assign sign_bits = { rdata[63],
+                         rdata[55],
+                         rdata[47],
+                         rdata[39],
+                         rdata[31],
+                         rdata[23],
+                         rdata[15],
+                         rdata[7]  };
 
     // select correct sign bit in parallel to result shifter above
     // pull to 0 if unsigned
-    assign sign_bit       = signed_q & sign_bits[idx_q] | fp_sign_q;
+    assign sign_bit       = out_data.sign_ext & sign_bits[out_data.sign_idx] | out_data.fp_sign;
 
     // result mux
     always_comb begin
-        unique case (load_data_q.operator)
+        unique case (out_data.operator)
             LW, LWU, FLW:    result_o = {{32{sign_bit}}, shifted_data[31:0]};
             LH, LHU, FLH:    result_o = {{48{sign_bit}}, shifted_data[15:0]};
             LB, LBU, FLB:    result_o = {{56{sign_bit}}, shifted_data[7:0]};
             default:    result_o = shifted_data;
         endcase
     end
-
-    always_ff @(posedge clk_i or negedge rst_ni) begin : p_regs
-        if (~rst_ni) begin
-            idx_q     <= 0;
-            signed_q  <= 0;
-            fp_sign_q <= 0;
-        end else begin
-            idx_q     <= idx_d;
-            signed_q  <= signed_d;
-            fp_sign_q <= fp_sign_d;
-        end
-    end
     // end result mux fast
 
 ///////////////////////////////////////////////////////
@@ -351,11 +558,11 @@ module load_unit (
 `ifndef VERILATOR
     // check invalid offsets
     addr_offset0: assert property (@(posedge clk_i) disable iff (~rst_ni)
-        valid_o |->  (load_data_q.operator inside {LW, LWU}) |-> load_data_q.address_offset < 5) else $fatal (1,"invalid address offset used with {LW, LWU}");
+        valid_o |->  (out_data.operator inside {LW, LWU}) |-> out_data.address_offset < 5) else $fatal (1,"invalid address offset used with {LW, LWU}");
     addr_offset1: assert property (@(posedge clk_i) disable iff (~rst_ni)
-        valid_o |->  (load_data_q.operator inside {LH, LHU}) |-> load_data_q.address_offset < 7) else $fatal (1,"invalid address offset used with {LH, LHU}");
+        valid_o |->  (out_data.operator inside {LH, LHU}) |-> out_data.address_offset < 7) else $fatal (1,"invalid address offset used with {LH, LHU}");
     addr_offset2: assert property (@(posedge clk_i) disable iff (~rst_ni)
-        valid_o |->  (load_data_q.operator inside {LB, LBU}) |-> load_data_q.address_offset < 8) else $fatal (1,"invalid address offset used with {LB, LBU}");
+        valid_o |->  (out_data.operator inside {LB, LBU}) |-> out_data.address_offset < 8) else $fatal (1,"invalid address offset used with {LB, LBU}");
 `endif
 //pragma translate_on
 
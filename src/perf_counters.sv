@@ -32,11 +32,17 @@ module perf_counters #(
     // from L1 caches
     input  logic                                    l1_icache_miss_i,
     input  logic                                    l1_dcache_miss_i,
+    input  logic                                    l1_dcache_prefetch_i,     // a line is prefetched
+    input  logic                                    l1_dcache_prefetch_hit_i, // a load accessed a prefetched line
     // from MMU
     input  logic                                    itlb_miss_i,
     input  logic                                    dtlb_miss_i,
+    // from LSU
+    input  logic                                    ld_forward_i,       // load got data from the store buffer
+    input  logic                                    ld_stall_i,         // load waits for the store buffer to drain
     // from issue stage
     input  logic                                    sb_full_i,
+    input  logic [TRANS_ID_BITS-1:0]                sb_occupancy_i,     // allocated scoreboard entries
     // from frontend
     input  logic                                    if_empty_i,
     // from PC Gen
@@ -45,7 +51,11 @@ module perf_counters #(
     input  branchpredict_t                          resolved_branch_i
 );
 
-    logic [riscv::CSR_IF_EMPTY[4:0] : riscv::CSR_L1_ICACHE_MISS[4:0]][63:0] perf_counter_d, perf_counter_q;
+    logic [riscv::CSR_L1_DCACHE_PREFETCH_HIT[4:0] : riscv::CSR_L1_ICACHE_MISS[4:0]][63:0] perf_counter_d, perf_counter_q;
+    logic [4:0] sb_occupancy_addr;
+
+    // the upper two bits of the occupancy select the quarter of the scoreboard
+    assign sb_occupancy_addr = riscv::CSR_SB_OCC_Q0[4:0] + sb_occupancy_i[TRANS_ID_BITS-1 -: 2];
 
     always_comb begin : perf_counters
         perf_counter_d = perf_counter_q;
@@ -62,6 +72,13 @@ module perf_counters #(
             if (l1_dcache_miss_i)
                 perf_counter_d[riscv::CSR_L1_DCACHE_MISS[4:0]] = perf_counter_q[riscv::CSR_L1_DCACHE_MISS[4:0]] + 1'b1;
 
+            // accuracy is hits over prefetches, coverage hits over hits plus misses
+            if (l1_dcache_prefetch_i)
+                perf_counter_d[riscv::CSR_L1_DCACHE_PREFETCH[4:0]] = perf_counter_q[riscv::CSR_L1_DCACHE_PREFETCH[4:0]] + 1'b1;
+
+            if (l1_dcache_prefetch_hit_i)
+                perf_counter_d[riscv::CSR_L1_DCACHE_PREFETCH_HIT[4:0]] = perf_counter_q[riscv::CSR_L1_DCACHE_PREFETCH_HIT[4:0]] + 1'b1;
+
             if (itlb_miss_i)
                 perf_counter_d[riscv::CSR_ITLB_MISS[4:0]] = perf_counter_q[riscv::CSR_ITLB_MISS[4:0]] + 1'b1;
 
@@ -100,6 +117,22 @@ module perf_counters #(
             if (resolved_branch_i.valid && resolved_branch_i.is_mispredict)
                 perf_counter_d[riscv::CSR_MIS_PREDICT[4:0]] = perf_counter_q[riscv::CSR_MIS_PREDICT[4:0]] + 1'b1;
 
+            // direction mis-predicts of conditional branches only, to compare BHT configurations
+            if (resolved_branch_i.valid && resolved_branch_i.is_mispredict && resolved_branch_i.cf_type == BHT)
+                perf_counter_d[riscv::CSR_BHT_MIS_PREDICT[4:0]] = perf_counter_q[riscv::CSR_BHT_MIS_PREDICT[4:0]] + 1'b1;
+
+            // returns which got their target from the RAS
+            if (resolved_branch_i.valid && resolved_branch_i.cf_type == RAS) begin
+                if (resolved_branch_i.is_mispredict)
+                    perf_counter_d[riscv::CSR_RAS_MISS[4:0]] = perf_counter_q[riscv::CSR_RAS_MISS[4:0]] + 1'b1;
+                else
+                    perf_counter_d[riscv::CSR_RAS_HIT[4:0]] = perf_counter_q[riscv::CSR_RAS_HIT[4:0]] + 1'b1;
+            end
+
+            // indirect jumps whose target came from the BTB or the indirect predictor
+            if (resolved_branch_i.valid && resolved_branch_i.is_mispredict && resolved_branch_i.cf_type == BTB)
+                perf_counter_d[riscv::CSR_BTB_MIS_PREDICT[4:0]] = perf_counter_q[riscv::CSR_BTB_MIS_PREDICT[4:0]] + 1'b1;
+
             if (sb_full_i) begin
                 perf_counter_d[riscv::CSR_SB_FULL[4:0]] = perf_counter_q[riscv::CSR_SB_FULL[4:0]] + 1'b1;
             end
@@ -107,6 +140,16 @@ module perf_counters #(
             if (if_empty_i) begin
                 perf_counter_d[riscv::CSR_IF_EMPTY[4:0]] = perf_counter_q[riscv::CSR_IF_EMPTY[4:0]] + 1'b1;
             end
+
+            // loads which overlap with a store in the store buffer
+            if (ld_forward_i)
+                perf_counter_d[riscv::CSR_LD_FORWARD[4:0]] = perf_counter_q[riscv::CSR_LD_FORWARD[4:0]] + 1'b1;
+
+            if (ld_stall_i)
+                perf_counter_d[riscv::CSR_LD_ST_STALL[4:0]] = perf_counter_q[riscv::CSR_LD_ST_STALL[4:0]] + 1'b1;
+
+            // scoreboard occupancy histogram, every cycle counts into one of the quarters
+            perf_counter_d[sb_occupancy_addr] = perf_counter_q[sb_occupancy_addr] + 1'b1;
         end
 
         // write after read
@@ -22,6 +22,7 @@ module scoreboard #(
     input  logic                                      clk_i,    // Clock
     input  logic                                      rst_ni,   // Asynchronous reset active low
     output logic                                      sb_full_o,
+    output logic [$clog2(NR_ENTRIES)-1:0]             sb_occupancy_o, // number of allocated entries
     input  logic                                      flush_unissued_instr_i, // flush only un-issued instructions
     input  logic                                      flush_i,  // flush whole scoreboard
     input  logic                                      unresolved_branch_i, // we have an unresolved branch
@@ -29,14 +30,14 @@ module scoreboard #(
     output fu_t [2**REG_ADDR_SIZE:0]                  rd_clobber_gpr_o,
     output fu_t [2**REG_ADDR_SIZE:0]                  rd_clobber_fpr_o,
 
-    // regfile like interface to operand read stage
-    input  logic [REG_ADDR_SIZE-1:0]                  rs1_i,
-    output logic [63:0]                               rs1_o,
-    output logic                                      rs1_valid_o,
+    // regfile like interface to operand read stage, one read port per issue lane
+    input  logic [ISSUE_WIDTH-1:0][REG_ADDR_SIZE-1:0] rs1_i,
+    output logic [ISSUE_WIDTH-1:0][63:0]              rs1_o,
+    output logic [ISSUE_WIDTH-1:0]                    rs1_valid_o,
 
-    input  logic [REG_ADDR_SIZE-1:0]                  rs2_i,
-    output logic [63:0]                               rs2_o,
-    output logic                                      rs2_valid_o,
+    input  logic [ISSUE_WIDTH-1:0][REG_ADDR_SIZE-1:0] rs2_i,
+    output logic [ISSUE_WIDTH-1:0][63:0]              rs2_o,
+    output logic [ISSUE_WIDTH-1:0]                    rs2_valid_o,
 
     input  logic [REG_ADDR_SIZE-1:0]                  rs3_i,
     output logic [FLEN-1:0]                           rs3_o,
@@ -48,14 +49,15 @@ module scoreboard #(
 
     // instruction to put on top of scoreboard e.g.: top pointer
     // we can always put this instruction to the top unless we signal with asserted full_o
-    input  scoreboard_entry_t                         decoded_instr_i,
-    input  logic                                      decoded_instr_valid_i,
-    output logic                                      decoded_instr_ack_o,
+    // the oldest instruction is on lane 0, the lanes are acknowledged in order
+    input  scoreboard_entry_t [ISSUE_WIDTH-1:0]       decoded_instr_i,
+    input  logic              [ISSUE_WIDTH-1:0]       decoded_instr_valid_i,
+    output logic              [ISSUE_WIDTH-1:0]       decoded_instr_ack_o,
 
     // instruction to issue logic, if issue_instr_valid and issue_ready is asserted, advance the issue pointer
-    output scoreboard_entry_t                         issue_instr_o,
-    output logic                                      issue_instr_valid_o,
-    input  logic                                      issue_ack_i,
+    output scoreboard_entry_t [ISSUE_WIDTH-1:0]       issue_instr_o,
+    output logic              [ISSUE_WIDTH-1:0]       issue_instr_valid_o,
+    input  logic              [ISSUE_WIDTH-1:0]       issue_ack_i,
 
     // write-back port
     input branchpredict_t                             resolved_branch_i,
@@ -75,12 +77,16 @@ module scoreboard #(
     logic [BITS_ENTRIES-1:0] issue_cnt_n,      issue_cnt_q;
     logic [BITS_ENTRIES-1:0] issue_pointer_n,  issue_pointer_q;
     logic [BITS_ENTRIES-1:0] commit_pointer_n, commit_pointer_q;
-    logic                          issue_full;
+    logic [ISSUE_WIDTH-1:0]  issue_full;
 
-    // the issue queue is full don't issue any new instructions
-    assign issue_full = (issue_cnt_q == NR_ENTRIES-1);
+    // the issue queue is full don't issue any new instructions, every
+    // additional lane needs one more free entry
+    for (genvar i = 0; i < ISSUE_WIDTH; i++) begin : gen_issue_full
+        assign issue_full[i] = (issue_cnt_q >= NR_ENTRIES-1-i);
+    end
 
-    assign sb_full_o = issue_full;
+    assign sb_full_o      = issue_full[0];
+    assign sb_occupancy_o = issue_cnt_q;
 
     // output commit instruction directly
     always_comb begin : commit_ports
@@ -90,13 +96,15 @@ module scoreboard #(
 
     // an instruction is ready for issue if we have place in the issue FIFO and it the decoder says it is valid
     always_comb begin
-        issue_instr_o          = decoded_instr_i;
-        // make sure we assign the correct trans ID
-        issue_instr_o.trans_id = issue_pointer_q;
-        // we are ready if we are not full and don't have any unresolved branches, but it can be
-        // the case that we have an unresolved branch which is cleared in that cycle (resolved_branch_i == 1)
-        issue_instr_valid_o    = decoded_instr_valid_i && !unresolved_branch_i && !issue_full;
-        decoded_instr_ack_o    = issue_ack_i && !issue_full;
+        for (int unsigned i = 0; i < ISSUE_WIDTH; i++) begin
+            issue_instr_o[i]          = decoded_instr_i[i];
+            // make sure we assign the correct trans ID
+            issue_instr_o[i].trans_id = issue_pointer_q + i;
+            // we are ready if we are not full and don't have any unresolved branches, but it can be
+            // the case that we have an unresolved branch which is cleared in that cycle (resolved_branch_i == 1)
+            issue_instr_valid_o[i]    = decoded_instr_valid_i[i] && !unresolved_branch_i && !issue_full[i];
+            decoded_instr_ack_o[i]    = issue_ack_i[i] && !issue_full[i];
+        end
     end
 
     // maintain a FIFO with issued instructions
@@ -113,13 +121,15 @@ module scoreboard #(
         issue_pointer_n  = issue_pointer_q;
 
         // if we got a acknowledge from the issue stage, put this scoreboard entry in the queue
-        if (decoded_instr_valid_i && decoded_instr_ack_o && !flush_unissued_instr_i) begin
-            // the decoded instruction we put in there is valid (1st bit)
-            // increase the issue counter
-            issue_cnt++;
-            mem_n[issue_pointer_q] = {1'b1, decoded_instr_i};
-            // advance issue pointer
-            issue_pointer_n = issue_pointer_q + 1'b1;
+        for (int unsigned i = 0; i < ISSUE_WIDTH; i++) begin
+            if (decoded_instr_valid_i[i] && decoded_instr_ack_o[i] && !flush_unissued_instr_i) begin
+                // the decoded instruction we put in there is valid (1st bit)
+                // increase the issue counter
+                issue_cnt++;
+                mem_n[issue_pointer_n] = {1'b1, decoded_instr_i[i]};
+                // advance issue pointer
+                issue_pointer_n = issue_pointer_n + 1'b1;
+            end
         end
 
         // ------------
@@ -206,63 +216,66 @@ module scoreboard #(
     // ----------------------------------
     // read operand interface: same logic as register file
     always_comb begin : read_operands
-        rs1_o       = 64'b0;
-        rs2_o       = 64'b0;
+        rs1_o       = '0;
+        rs2_o       = '0;
         rs3_o       = '0;
-        rs1_valid_o = 1'b0;
-        rs2_valid_o = 1'b0;
+        rs1_valid_o = '0;
+        rs2_valid_o = '0;
         rs3_valid_o = 1'b0;
 
-        for (int unsigned i = 0; i < NR_ENTRIES; i++) begin
-            // only consider this entry if it is valid
-            if (mem_q[i].issued) begin
-                // look at the appropriate fields and look whether there was an
-                // instruction that wrote the rd field before, first for RS1 and then for RS2, then for RS3
-                // we check the type of the stored result register file against issued register file
-                if ((mem_q[i].sbe.rd == rs1_i) && (is_rd_fpr(mem_q[i].sbe.op) == is_rs1_fpr(issue_instr_o.op))) begin
-                    rs1_o       = mem_q[i].sbe.result;
-                    rs1_valid_o = mem_q[i].sbe.valid;
-                end else if ((mem_q[i].sbe.rd == rs2_i) && (is_rd_fpr(mem_q[i].sbe.op) == is_rs2_fpr(issue_instr_o.op))) begin
-                    rs2_o       = mem_q[i].sbe.result;
-                    rs2_valid_o = mem_q[i].sbe.valid;
-                end else if ((mem_q[i].sbe.rd == rs3_i) && (is_rd_fpr(mem_q[i].sbe.op) == is_imm_fpr(issue_instr_o.op))) begin
-                    rs3_o       = mem_q[i].sbe.result;
-                    rs3_valid_o = mem_q[i].sbe.valid;
+        for (int unsigned l = 0; l < ISSUE_WIDTH; l++) begin
+            for (int unsigned i = 0; i < NR_ENTRIES; i++) begin
+                // only consider this entry if it is valid
+                if (mem_q[i].issued) begin
+                    // look at the appropriate fields and look whether there was an
+                    // instruction that wrote the rd field before, first for RS1 and then for RS2, then for RS3
+                    // we check the type of the stored result register file against issued register file
+                    if ((mem_q[i].sbe.rd == rs1_i[l]) && (is_rd_fpr(mem_q[i].sbe.op) == is_rs1_fpr(issue_instr_o[l].op))) begin
+                        rs1_o[l]       = mem_q[i].sbe.result;
+                        rs1_valid_o[l] = mem_q[i].sbe.valid;
+                    end else if ((mem_q[i].sbe.rd == rs2_i[l]) && (is_rd_fpr(mem_q[i].sbe.op) == is_rs2_fpr(issue_instr_o[l].op))) begin
+                        rs2_o[l]       = mem_q[i].sbe.result;
+                        rs2_valid_o[l] = mem_q[i].sbe.valid;
+                    // the third operand only exists on the first lane
+                    end else if (l == 0 && (mem_q[i].sbe.rd == rs3_i) && (is_rd_fpr(mem_q[i].sbe.op) == is_imm_fpr(issue_instr_o[0].op))) begin
+                        rs3_o       = mem_q[i].sbe.result;
+                        rs3_valid_o = mem_q[i].sbe.valid;
+                    end
                 end
             end
-        end
 
-        // -----------
-        // Forwarding
-        // -----------
-        // provide a direct combinational path from WB a.k.a forwarding
-        // make sure that we are not forwarding a result that got an exception
-        for (int unsigned j = 0; j < NR_WB_PORTS; j++) begin
-            if (mem_q[trans_id_i[j]].sbe.rd == rs1_i && wb_valid_i[j] && ~ex_i[j].valid
-               && (is_rd_fpr(mem_q[trans_id_i[j]].sbe.op) == is_rs1_fpr(issue_instr_o.op))) begin
-                rs1_o = wbdata_i[j];
-                rs1_valid_o = wb_valid_i[j];
-                break;
-            end
-            if (mem_q[trans_id_i[j]].sbe.rd == rs2_i && wb_valid_i[j] && ~ex_i[j].valid
-               && (is_rd_fpr(mem_q[trans_id_i[j]].sbe.op) == is_rs2_fpr(issue_instr_o.op))) begin
-                rs2_o = wbdata_i[j];
-                rs2_valid_o = wb_valid_i[j];
-                break;
-            end
-            if (mem_q[trans_id_i[j]].sbe.rd == rs3_i && wb_valid_i[j] && ~ex_i[j].valid
-               && (is_rd_fpr(mem_q[trans_id_i[j]].sbe.op) == is_imm_fpr(issue_instr_o.op))) begin
-                rs3_o = wbdata_i[j];
-                rs3_valid_o = wb_valid_i[j];
-                break;
+            // -----------
+            // Forwarding
+            // -----------
+            // provide a direct combinational path from WB a.k.a forwarding
+            // make sure that we are not forwarding a result that got an exception
+            for (int unsigned j = 0; j < NR_WB_PORTS; j++) begin
+                if (mem_q[trans_id_i[j]].sbe.rd == rs1_i[l] && wb_valid_i[j] && ~ex_i[j].valid
+                   && (is_rd_fpr(mem_q[trans_id_i[j]].sbe.op) == is_rs1_fpr(issue_instr_o[l].op))) begin
+                    rs1_o[l] = wbdata_i[j];
+                    rs1_valid_o[l] = wb_valid_i[j];
+                    break;
+                end
+                if (mem_q[trans_id_i[j]].sbe.rd == rs2_i[l] && wb_valid_i[j] && ~ex_i[j].valid
+                   && (is_rd_fpr(mem_q[trans_id_i[j]].sbe.op) == is_rs2_fpr(issue_instr_o[l].op))) begin
+                    rs2_o[l] = wbdata_i[j];
+                    rs2_valid_o[l] = wb_valid_i[j];
+                    break;
+                end
+                if (l == 0 && mem_q[trans_id_i[j]].sbe.rd == rs3_i && wb_valid_i[j] && ~ex_i[j].valid
+                   && (is_rd_fpr(mem_q[trans_id_i[j]].sbe.op) == is_imm_fpr(issue_instr_o[0].op))) begin
+                    rs3_o = wbdata_i[j];
+                    rs3_valid_o = wb_valid_i[j];
+                    break;
+                end
             end
-        end
 
-        // make sure we didn't read the zero register
-        if (rs1_i == '0 && ~is_rs1_fpr(issue_instr_o.op)) // only GPR reg0 is 0
-            rs1_valid_o = 1'b0;
-        if (rs2_i == '0 && ~is_rs2_fpr(issue_instr_o.op)) // only GPR reg0 is 0
-            rs2_valid_o = 1'b0;
+            // make sure we didn't read the zero register
+            if (rs1_i[l] == '0 && ~is_rs1_fpr(issue_instr_o[l].op)) // only GPR reg0 is 0
+                rs1_valid_o[l] = 1'b0;
+            if (rs2_i[l] == '0 && ~is_rs2_fpr(issue_instr_o[l].op)) // only GPR reg0 is 0
+                rs2_valid_o[l] = 1'b0;
+        end
     end
 
     // sequential process
@@ -284,6 +297,7 @@ module scoreboard #(
     `ifndef VERILATOR
     initial begin
         assert (NR_ENTRIES == 2**BITS_ENTRIES) else $fatal("Scoreboard size needs to be a power of two.");
+        assert (NR_ENTRIES >= 8 && NR_ENTRIES <= 32) else $fatal("Scoreboard size needs to be 8, 16 or 32.");
     end
 
     // assert that zero is never set
@@ -300,9 +314,18 @@ module scoreboard #(
         else $error ("Commit acknowledged but instruction is not valid");
 
     // assert that we never give an issue ack signal if the instruction is not valid
-    assert property (
-        @(posedge clk_i) (rst_ni && issue_ack_i |-> issue_instr_valid_o))
-        else $error ("Issue acknowledged but instruction is not valid");
+    for (genvar i = 0; i < ISSUE_WIDTH; i++) begin
+        assert property (
+            @(posedge clk_i) (rst_ni && issue_ack_i[i] |-> issue_instr_valid_o[i]))
+            else $error ("Issue acknowledged but instruction is not valid");
+    end
+
+    // a younger lane can only issue together with all older lanes
+    for (genvar i = 1; i < ISSUE_WIDTH; i++) begin
+        assert property (
+            @(posedge clk_i) (rst_ni && issue_ack_i[i] |-> issue_ack_i[i-1]))
+            else $error ("Issue lanes acknowledged out of order");
+    end
 
     // there should never be more than one instruction writing the same destination register (except x0)
     // check that no functional unit is retiring with the same transaction id
@@ -24,6 +24,10 @@ module store_buffer (
 
     input  logic [11:0]  page_offset_i,         // check for the page offset (the last 12 bit if the current load matches them)
     output logic         page_offset_matches_o, // the above input page offset matches -> let the store buffer drain
+    // store to load forwarding
+    input  logic [63:0]  fwd_paddr_i,           // physical address of the load
+    output logic [63:0]  fwd_data_o,            // youngest data of each byte of the double word
+    output logic [7:0]   fwd_be_o,              // bytes which have been found in the buffer
 
     input  logic         commit_i,        // commit the instruction which was placed there most recently
     output logic         commit_ready_o,  // commit queue is ready to accept another commit request
@@ -218,6 +222,44 @@ module store_buffer (
     end
 
 
+    // ------------------
+    // Forwarding
+    // ------------------
+    // Collect the bytes of all stores to the same double word as the load. The commit queue
+    // holds the older stores and in both queues the entries get younger starting from the read
+    // pointer, so going through them in this order lets the youngest store win.
+    always_comb begin : forwarding
+        automatic logic [$clog2(DEPTH_COMMIT)-1:0] commit_idx;
+        automatic logic [$clog2(DEPTH_SPEC)-1:0]   speculative_idx;
+
+        fwd_data_o = '0;
+        fwd_be_o   = '0;
+
+        for (int unsigned i = 0; i < DEPTH_COMMIT; i++) begin
+            commit_idx = commit_read_pointer_q + i;
+            if (commit_queue_q[commit_idx].valid && (commit_queue_q[commit_idx].address[63:3] == fwd_paddr_i[63:3])) begin
+                for (int unsigned j = 0; j < 8; j++) begin
+                    if (commit_queue_q[commit_idx].be[j]) begin
+                        fwd_be_o[j]          = 1'b1;
+                        fwd_data_o[j*8 +: 8] = commit_queue_q[commit_idx].data[j*8 +: 8];
+                    end
+                end
+            end
+        end
+
+        for (int unsigned i = 0; i < DEPTH_SPEC; i++) begin
+            speculative_idx = speculative_read_pointer_q + i;
+            if (speculative_queue_q[speculative_idx].valid && (speculative_queue_q[speculative_idx].address[63:3] == fwd_paddr_i[63:3])) begin
+                for (int unsigned j = 0; j < 8; j++) begin
+                    if (speculative_queue_q[speculative_idx].be[j]) begin
+                        fwd_be_o[j]          = 1'b1;
+                        fwd_data_o[j*8 +: 8] = speculative_queue_q[speculative_idx].data[j*8 +: 8];
+                    end
+                end
+            end
+        end
+    end
+
     // registers
     always_ff @(posedge clk_i or negedge rst_ni) begin : p_spec
         if (~rst_ni) begin
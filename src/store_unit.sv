@@ -40,6 +40,10 @@ module store_unit (
     // address checker
     input  logic [11:0]              page_offset_i,
     output logic                     page_offset_matches_o,
+    // store to load forwarding
+    input  logic [63:0]              fwd_paddr_i,
+    output logic [63:0]              fwd_data_o,
+    output logic [7:0]               fwd_be_o,
     // D$ interface
     output amo_req_t                 amo_req_o,
     input  amo_resp_t                amo_resp_i,
@@ -219,6 +223,9 @@ module store_unit (
         .no_st_pending_o,
         .page_offset_i,
         .page_offset_matches_o,
+        .fwd_paddr_i,
+        .fwd_data_o,
+        .fwd_be_o,
         .commit_i,
         .commit_ready_o,
         .ready_o               ( store_buffer_ready     ),
@@ -27,8 +27,8 @@ interface instruction_tracer_if (
     logic             fetch_valid;
     logic             fetch_ack;
     // Issue stage
-    logic               issue_ack; // issue acknowledged
-    scoreboard_entry_t  issue_sbe; // issue scoreboard entry
+    logic              [ISSUE_WIDTH-1:0] issue_ack; // issue acknowledged
+    scoreboard_entry_t [ISSUE_WIDTH-1:0] issue_sbe; // issue scoreboard entry
     // WB stage
     logic [1:0][4:0]  waddr;
     logic [1:0][63:0] wdata;
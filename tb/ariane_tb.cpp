@@ -33,6 +33,8 @@
 
 #include <fesvr/dtm.h>
 #include "remote_bitbang.h"
+#include "dram_image.h"
+#include "replay.h"
 // This software is heavily based on Rocket Chip
 // Checkout this awesome project:
 // https://github.com/freechipsproject/rocket-chip/
@@ -45,10 +47,17 @@ static vluint64_t main_time = 0;
 static const char *verilog_plusargs[] = {"jtag_rbb_enable"};
 
 extern dtm_t* dtm;
+extern bool dtm_disabled;
 extern remote_bitbang_t * jtag;
+extern dram_image_t * dram;
+
+static volatile sig_atomic_t terminated = 0;
 
 void handle_sigterm(int sig) {
-  dtm->stop();
+  if (dtm)
+    dtm->stop();
+  else
+    terminated = 1;
 }
 
 // Called by $time in Verilog converts to double, to match what SystemC does
@@ -68,6 +77,19 @@ EMULATOR OPTIONS\n\
   -r, --rbb-port=PORT      Use PORT for remote bit bang (with OpenOCD and GDB) \n\
                            If not specified, a random port will be chosen\n\
                            automatically.\n\
+  -d, --dram-image=FILE    Back the main memory with FILE (mmap'ed), e.g. a\n\
+                           preloaded kernel + rootfs image. Offset 0 of FILE\n\
+                           maps to the base of the DRAM. Use `none' as BINARY\n\
+                           to skip loading an ELF through the debug module.\n\
+  -S, --dram-shared        Map the image shared: all stores go to FILE so that\n\
+                           the final memory state can be inspected after the\n\
+                           run (or a crash). The default is a private\n\
+                           copy-on-write mapping which leaves FILE untouched.\n\
+  -s, --seed=SEED          Use random SEED (e.g.: for the random AXI stalls)\n\
+  -R, --record=FILE        Record all nondeterministic inputs (seed, debug\n\
+                           transport and remote bitbang) to FILE\n\
+  -L, --replay=FILE        Replay a run recorded with --record bit-exactly, no\n\
+                           OpenOCD needs to be connected\n\
 ", stdout);
 #if VM_TRACE == 0
   fputs("\
@@ -92,8 +114,10 @@ EMULATOR DEBUG OPTIONS (only supported in debug build -- try `make debug`)\n",
 "    %s -v rv64ui-p-add.vcd $RISCV/riscv64-unknown-elf/share/riscv-tests/isa/rv64ui-p-add\n"
 #endif
 "  - run an ELF (you wrote, called 'hello') using the proxy kernel:\n"
-"    %s pk hello\n",
-         program_name, program_name, program_name
+"    %s pk hello\n"
+"  - boot a preloaded memory image without loading an ELF:\n"
+"    %s --dram-image=bbl.img none\n",
+         program_name, program_name, program_name, program_name
 #if VM_TRACE
          , program_name
 #endif
@@ -111,6 +135,10 @@ int main(int argc, char **argv) {
   bool print_cycles = false;
   // Port numbers are 16 bit unsigned integers.
   uint16_t rbb_port = 0;
+  const char * dram_image = NULL;
+  bool dram_shared = false;
+  const char * replay_file = NULL;
+  bool record = false;
 #if VM_TRACE
   FILE * vcdfile = NULL;
   uint64_t start = 0;
@@ -125,6 +153,10 @@ int main(int argc, char **argv) {
       {"max-cycles",  required_argument, 0, 'm' },
       {"seed",        required_argument, 0, 's' },
       {"rbb-port",    required_argument, 0, 'r' },
+      {"dram-image",  required_argument, 0, 'd' },
+      {"dram-shared", no_argument,       0, 'S' },
+      {"record",      required_argument, 0, 'R' },
+      {"replay",      required_argument, 0, 'L' },
       {"verbose",     no_argument,       0, 'V' },
 #if VM_TRACE
       {"vcd",         required_argument, 0, 'v' },
@@ -134,9 +166,9 @@ int main(int argc, char **argv) {
     };
     int option_index = 0;
 #if VM_TRACE
-    int c = getopt_long(argc, argv, "-chpm:s:r:v:Vx:", long_options, &option_index);
+    int c = getopt_long(argc, argv, "-chpm:s:r:d:SR:L:v:Vx:", long_options, &option_index);
 #else
-    int c = getopt_long(argc, argv, "-chpm:s:r:V", long_options, &option_index);
+    int c = getopt_long(argc, argv, "-chpm:s:r:d:SR:L:V", long_options, &option_index);
 #endif
     if (c == -1) break;
  retry:
@@ -148,6 +180,12 @@ int main(int argc, char **argv) {
       case 'm': max_cycles = atoll(optarg); break;
       case 's': random_seed = atoi(optarg); break;
       case 'r': rbb_port = atoi(optarg);    break;
+      case 'd': dram_image = optarg;        break;
+      case 'S': dram_shared = true;         break;
+      case 'R': replay_file = optarg;
+                record = true;              break;
+      case 'L': replay_file = optarg;
+                record = false;             break;
       case 'V': verbose = true;             break;
       case 'p': perf = true;                break;
 #if VM_TRACE
@@ -243,11 +281,43 @@ done_processing:
   htif_argv[0] = argv[0];
   for (int i = 1; optind < argc;) htif_argv[i++] = argv[optind++];
 
+  // `none' as BINARY: the program is part of the preloaded DRAM image and
+  // nothing needs to be loaded through the debug module
+  bool no_binary = false;
+  for (int i = 1; i < htif_argc; i++) {
+    if (htif_argv[i][0] != '+' && htif_argv[i][0] != '-') {
+      no_binary = strcmp(htif_argv[i], "none") == 0;
+      break;
+    }
+  }
+  if (no_binary && !dram_image) {
+    std::cerr << "BINARY `none' needs a preloaded --dram-image\n";
+    usage(argv[0]);
+    return 1;
+  }
+
   const char *vcd_file = NULL;
   Verilated::commandArgs(argc, argv);
 
+  // the seed is part of the recorded inputs
+  if (replay_file) {
+    replay = new replay_t(replay_file, record);
+    random_seed = replay->value(replay_t::SEED, random_seed);
+  }
+  // $random and $urandom of the Verilator runtime draw from lrand48()
+  srand48(random_seed);
+  srand(random_seed);
+  srandom(random_seed);
+
   jtag = new remote_bitbang_t(rbb_port);
-  dtm = new dtm_t(htif_argc, htif_argv);
+  // the memory gets mapped once the model is initialized (and the memory size
+  // is known), see SimDRAM.sv
+  if (dram_image)
+    dram = new dram_image_t(dram_image, dram_shared);
+  if (no_binary)
+    dtm_disabled = true;
+  else
+    dtm = new dtm_t(htif_argc, htif_argv);
   signal(SIGTERM, handle_sigterm);
 
   std::unique_ptr<Variane_testharness> top(new Variane_testharness);
@@ -279,7 +349,7 @@ done_processing:
   }
   top->rst_ni = 1;
 
-  while (!dtm->done() && !jtag->done()) {
+  while (!(dtm && dtm->done()) && !jtag->done() && !(replay && replay->done()) && !terminated) {
     top->clk_i = 0;
     top->eval();
 #if VM_TRACE
@@ -308,8 +378,11 @@ done_processing:
     fclose(vcdfile);
 #endif
 
-  if (dtm->exit_code()) {
-    fprintf(stderr, "%s *** FAILED *** (code = %d) after %ld cycles\n", htif_argv[1], dtm->exit_code(), main_time);
+  if (replay && replay->exit_code()) {
+    fprintf(stderr, "%s *** FAILED *** (code = %d, replayed) after %ld cycles\n", htif_argv[1], replay->exit_code(), main_time);
+    ret = replay->exit_code();
+  } else if (dtm && dtm->exit_code()) {
+    fprintf(stderr, "%s *** FAILED *** (code = %d, seed %d) after %ld cycles\n", htif_argv[1], dtm->exit_code(), random_seed, main_time);
     ret = dtm->exit_code();
   } else if (jtag->exit_code()) {
     fprintf(stderr, "%s *** FAILED *** (code = %d, seed %d) after %ld cycles\n", htif_argv[1], jtag->exit_code(), random_seed, main_time);
@@ -320,6 +393,8 @@ done_processing:
 
   if (dtm) delete dtm;
   if (jtag) delete jtag;
+  if (dram) delete dram;
+  if (replay) delete replay;
 
   std::clock_t c_end = std::clock();
   auto t_end = std::chrono::high_resolution_clock::now();
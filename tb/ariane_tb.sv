@@ -24,6 +24,10 @@ import uvm_pkg::*;
 import "DPI-C" function read_elf(input string filename);
 import "DPI-C" function byte get_section(output longint address, output longint len);
 import "DPI-C" context function byte read_section(input longint address, inout byte buffer[]);
+import "DPI-C" context function byte read_section_chunk(input longint address, input longint offset, inout byte buffer[], input longint len);
+// symbol lookups on the preloaded ELF (e.g.: to symbolize PCs in monitors)
+import "DPI-C" function byte get_symbol_address(input string name, output longint address);
+import "DPI-C" function string get_symbol_name(input longint address, output longint offset);
 
 module ariane_tb;
 
@@ -34,6 +38,8 @@ module ariane_tb;
     localparam int unsigned RTC_CLOCK_PERIOD = 30.517us;
 
     localparam NUM_WORDS = 2**25;
+    // sections are preloaded in chunks of this many bytes (multiple of 8)
+    localparam longint unsigned PRELOAD_CHUNK = 2**20;
     logic clk_i;
     logic rst_ni;
     logic rtc_i;
@@ -102,8 +108,9 @@ module ariane_tb;
     // Note that we are loosing the capabilities to use risc-fesvr though
     initial begin
         automatic logic [7:0][7:0] mem_row;
-        longint address, len;
+        longint address, len, offset, chunk, start;
         byte buffer[];
+        byte ret;
         void'(uvcl.get_arg_value("+PRELOAD=", binary));
 
         if (binary != "") begin
@@ -113,20 +120,29 @@ module ariane_tb;
             // wait with preloading, otherwise randomization will overwrite the existing value
             wait(rst_ni);
 
+            buffer = new [PRELOAD_CHUNK];
             // while there are more sections to process
             while (get_section(address, len)) begin
                 `uvm_info( "Core Test", $sformatf("Loading Address: %x, Length: %x", address, len), UVM_LOW)
-                buffer = new [len];
-                void'(read_section(address, buffer));
-                // preload memories
-                // 64-bit
-                for (int i = 0; i < buffer.size()/8; i++) begin
-                    mem_row = '0;
-                    for (int j = 0; j < 8; j++) begin
-                        mem_row[j] = buffer[i*8 + j];
+                // stream the section, the buffer size is bounded by the chunk size
+                for (offset = 0; offset < len; offset += chunk) begin
+                    chunk = (len - offset > PRELOAD_CHUNK) ? PRELOAD_CHUNK : len - offset;
+                    ret = read_section_chunk(address, offset, buffer, chunk);
+                    if (ret != 0) begin
+                        `uvm_fatal( "Core Test", $sformatf("Could not read section %x at offset %x (error %0d)", address, offset, ret))
+                    end
+                    // preload memories
+                    // 64-bit, a partially covered row (at either end of the chunk) is read back
+                    // first so that bytes of a neighbouring section sharing the row are kept
+                    start = address[28:0] + offset;
+                    for (longint row = start >> 3; row <= (start + chunk - 1) >> 3; row++) begin
+                        mem_row = `MAIN_MEM(row);
+                        for (int j = 0; j < 8; j++) begin
+                            if (row*8 + j >= start && row*8 + j < start + chunk) mem_row[j] = buffer[row*8 + j - start];
+                        end
+
+                        `MAIN_MEM(row) = mem_row;
                     end
-
-                    `MAIN_MEM((address[28:0] >> 3) + i) = mem_row;
                 end
             end
         end
@@ -270,6 +270,11 @@ module ariane_testharness #(
     axi_pkg::b_chan_t  b_chan_i;
     axi_pkg::ar_chan_t ar_chan_o;
     axi_pkg::r_chan_t  r_chan_i;
+    // between the delayer and the wrap splitter
+    logic              ar_valid_delayed, ar_ready_delayed;
+    logic              r_valid_delayed, r_ready_delayed;
+    axi_pkg::ar_chan_t ar_chan_delayed;
+    axi_pkg::r_chan_t  r_chan_delayed;
 
     axi_delayer #(
         .aw_t              ( axi_pkg::aw_chan_t ),
@@ -308,12 +313,34 @@ module ariane_testharness #(
         .b_valid_i  ( dram.b_valid                      ),
         .b_chan_i   ( b_chan_i                          ),
         .b_ready_o  ( dram.b_ready                      ),
-        .ar_valid_o ( dram.ar_valid                     ),
-        .ar_chan_o  ( ar_chan_o                         ),
-        .ar_ready_i ( dram.ar_ready                     ),
-        .r_valid_i  ( dram.r_valid                      ),
-        .r_chan_i   ( r_chan_i                          ),
-        .r_ready_o  ( dram.r_ready                      )
+        .ar_valid_o ( ar_valid_delayed                  ),
+        .ar_chan_o  ( ar_chan_delayed                   ),
+        .ar_ready_i ( ar_ready_delayed                  ),
+        .r_valid_i  ( r_valid_delayed                   ),
+        .r_chan_i   ( r_chan_delayed                    ),
+        .r_ready_o  ( r_ready_delayed                   )
+    );
+
+    // the caches refill critical word first, axi2mem only knows incrementing bursts
+    axi_wrap_split #(
+        .AddrWidth ( AXI_ADDRESS_WIDTH  ),
+        .ar_t      ( axi_pkg::ar_chan_t ),
+        .r_t       ( axi_pkg::r_chan_t  )
+    ) i_axi_wrap_split (
+        .clk_i      ( clk_i            ),
+        .rst_ni     ( ndmreset_n       ),
+        .ar_valid_i ( ar_valid_delayed ),
+        .ar_chan_i  ( ar_chan_delayed  ),
+        .ar_ready_o ( ar_ready_delayed ),
+        .r_valid_o  ( r_valid_delayed  ),
+        .r_chan_o   ( r_chan_delayed   ),
+        .r_ready_i  ( r_ready_delayed  ),
+        .ar_valid_o ( dram.ar_valid    ),
+        .ar_chan_o  ( ar_chan_o        ),
+        .ar_ready_i ( dram.ar_ready    ),
+        .r_valid_i  ( dram.r_valid     ),
+        .r_chan_i   ( r_chan_i         ),
+        .r_ready_o  ( dram.r_ready     )
     );
 
     assign aw_chan_i.atop = '0;
@@ -409,6 +436,21 @@ module ariane_testharness #(
         .data_i ( rdata      )
     );
 
+`ifdef VERILATOR
+    // memory content is kept on the C++ side, optionally backed by an image
+    // file (see --dram-image in ariane_tb.cpp)
+    SimDRAM #(
+        .NUM_WORDS  ( NUM_WORDS      )
+    ) i_sram (
+        .clk_i      ( clk_i                                                                       ),
+        .req_i      ( req                                                                         ),
+        .we_i       ( we                                                                          ),
+        .addr_i     ( addr[$clog2(NUM_WORDS)-1+$clog2(AXI_DATA_WIDTH/8):$clog2(AXI_DATA_WIDTH/8)] ),
+        .wdata_i    ( wdata                                                                       ),
+        .be_i       ( be                                                                          ),
+        .rdata_o    ( rdata                                                                       )
+    );
+`else
     sram #(
         .DATA_WIDTH ( AXI_DATA_WIDTH ),
         .NUM_WORDS  ( NUM_WORDS      )
@@ -422,6 +464,7 @@ module ariane_testharness #(
         .be_i       ( be                                                                          ),
         .rdata_o    ( rdata                                                                       )
     );
+`endif
 
     // ---------------
     // AXI Xbar
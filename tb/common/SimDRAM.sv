@@ -0,0 +1,46 @@
+// Copyright 2018 ETH Zurich and University of Bologna.
+// Copyright and related rights are licensed under the Solderpad Hardware
+// License, Version 0.51 (the "License"); you may not use this file except in
+// compliance with the License.  You may obtain a copy of the License at
+// http://solderpad.org/licenses/SHL-0.51. Unless required by applicable law
+// or agreed to in writing, software, hardware and materials distributed under
+// this License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+//
+// Description: Simulation main memory, the content lives on the C++ side
+//              (tb/dpi/dram_image.cc) and can be backed by an mmap'ed image
+//              file. Drop-in replacement for the 64 bit `sram` (read latency
+//              of one cycle).
+
+import "DPI-C" function void dram_init(input longint size);
+import "DPI-C" function longint dram_read(input longint addr);
+import "DPI-C" function void dram_write(input longint addr, input longint wdata, input byte be);
+
+module SimDRAM #(
+    parameter int unsigned NUM_WORDS = 1024
+)(
+    input  logic                          clk_i,
+    input  logic                          req_i,
+    input  logic                          we_i,
+    input  logic [$clog2(NUM_WORDS)-1:0]  addr_i,
+    input  logic [63:0]                   wdata_i,
+    input  logic [7:0]                    be_i,
+    output logic [63:0]                   rdata_o
+);
+
+    initial begin
+        dram_init(longint'(NUM_WORDS) * 8);
+    end
+
+    always_ff @(posedge clk_i) begin
+        if (req_i) begin
+            if (we_i) begin
+                dram_write(longint'(addr_i) << 3, wdata_i, be_i);
+            end else begin
+                rdata_o <= dram_read(longint'(addr_i) << 3);
+            end
+        end
+    end
+
+endmodule
@@ -0,0 +1,126 @@
+// Copyright 2018 ETH Zurich and University of Bologna.
+// Copyright and related rights are licensed under the Solderpad Hardware
+// License, Version 0.51 (the "License"); you may not use this file except in
+// compliance with the License.  You may obtain a copy of the License at
+// http://solderpad.org/licenses/SHL-0.51. Unless required by applicable law
+// or agreed to in writing, software, hardware and materials distributed under
+// this License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+//
+// Description: Turns wrapping read bursts into incrementing ones for memories
+//              which only understand INCR (read channels only)
+
+// The caches refill their lines critical word first with a wrapping burst
+// which starts at the word that missed. A wrapping burst which does not start
+// on the wrap boundary is split into two incrementing bursts: from the start
+// address up to the end of the wrap window and from the beginning of the
+// window up to the start address. The last flag of the first half is dropped
+// on the way back so that the master sees a single burst, this relies on the
+// slave answering reads in order. Write bursts are passed through untouched.
+module axi_wrap_split #(
+    parameter int unsigned AddrWidth = 64,
+    parameter int unsigned MaxTrans  = 8,   // outstanding bursts towards the slave
+    parameter type         ar_t      = logic,
+    parameter type         r_t       = logic
+)(
+    input  logic clk_i,
+    input  logic rst_ni,
+    // from the master
+    input  logic ar_valid_i,
+    input  ar_t  ar_chan_i,
+    output logic ar_ready_o,
+    output logic r_valid_o,
+    output r_t   r_chan_o,
+    input  logic r_ready_i,
+    // to the slave
+    output logic ar_valid_o,
+    output ar_t  ar_chan_o,
+    input  logic ar_ready_i,
+    input  logic r_valid_i,
+    input  r_t   r_chan_i,
+    output logic r_ready_o
+);
+
+    logic                 second_d, second_q; // first half has been sent
+    logic                 split;
+    logic [7:0]           offset;             // beats between the wrap boundary and the start address
+    logic [AddrWidth-1:0] wrap_mask;          // address bits within the wrap window
+    logic                 fifo_full;
+    logic                 inner_last;         // the burst in flight is the first half of a split one
+
+    assign offset    = ar_chan_i.addr[ar_chan_i.size +: 8] & ar_chan_i.len;
+    assign wrap_mask = ({{(AddrWidth-8){1'b0}}, ar_chan_i.len} << ar_chan_i.size) | ~({AddrWidth{1'b1}} << ar_chan_i.size);
+    assign split     = (ar_chan_i.burst == 2'b10) && (offset != '0);
+
+    always_comb begin : ar_split
+        ar_chan_o  = ar_chan_i;
+        ar_valid_o = ar_valid_i && !fifo_full;
+        ar_ready_o = ar_ready_i && !fifo_full;
+        second_d   = second_q;
+
+        // a wrapping burst starting on the boundary is an incrementing one
+        if (ar_chan_i.burst == 2'b10)
+            ar_chan_o.burst = 2'b01;
+
+        if (split) begin
+            // ~> from the start address up to the end of the wrap window
+            if (!second_q) begin
+                ar_chan_o.len = ar_chan_i.len - offset;
+                ar_ready_o    = 1'b0;
+                if (ar_valid_o && ar_ready_i)
+                    second_d = 1'b1;
+            // ~> from the beginning of the window up to the start address
+            end else begin
+                ar_chan_o.addr = ar_chan_i.addr & ~wrap_mask;
+                ar_chan_o.len  = offset - 1;
+                if (ar_valid_o && ar_ready_i)
+                    second_d = 1'b0;
+            end
+        end
+    end
+
+    // remember which bursts towards the slave end in the middle of a burst of the master
+    fifo_v3 #(
+        .DATA_WIDTH ( 1        ),
+        .DEPTH      ( MaxTrans )
+    ) i_fifo_last (
+        .clk_i      ( clk_i                                  ),
+        .rst_ni     ( rst_ni                                 ),
+        .flush_i    ( 1'b0                                   ),
+        .testmode_i ( 1'b0                                   ),
+        .full_o     ( fifo_full                              ),
+        .empty_o    (                                        ), // leave open
+        .usage_o    (                                        ), // leave open
+        .data_i     ( split && !second_q                     ),
+        .push_i     ( ar_valid_o && ar_ready_i               ),
+        .data_o     ( inner_last                             ),
+        .pop_i      ( r_valid_i && r_ready_i && r_chan_i.last )
+    );
+
+    always_comb begin : r_merge
+        r_chan_o      = r_chan_i;
+        r_chan_o.last = r_chan_i.last && !inner_last;
+    end
+
+    assign r_valid_o = r_valid_i;
+    assign r_ready_o = r_ready_i;
+
+    always_ff @(posedge clk_i or negedge rst_ni) begin
+        if (~rst_ni) begin
+            second_q <= 1'b0;
+        end else begin
+            second_q <= second_d;
+        end
+    end
+
+//pragma translate_off
+`ifndef VERILATOR
+    // AXI only allows wrapping bursts of 2, 4, 8 or 16 beats
+    wrap_len: assert property (
+        @(posedge clk_i) disable iff (~rst_ni)
+            (ar_valid_i && ar_chan_i.burst == 2'b10) |-> (ar_chan_i.len inside {8'd1, 8'd3, 8'd7, 8'd15}))
+            else $fatal(1, "[axi_wrap_split] illegal length of a wrapping burst");
+`endif
+//pragma translate_on
+endmodule
@@ -0,0 +1,26 @@
+// Description: DPI interface of the file backed main memory (SimDRAM.sv)
+
+#include <svdpi.h>
+#include "dram_image.h"
+
+dram_image_t* dram;
+
+extern "C" void dram_init(long long size)
+{
+  // no image requested: plain zero-initialized memory
+  if (!dram) {
+    dram = new dram_image_t(NULL, false);
+  }
+
+  dram->map(size);
+}
+
+extern "C" long long dram_read(long long addr)
+{
+  return dram->read(addr);
+}
+
+extern "C" void dram_write(long long addr, long long wdata, char be)
+{
+  dram->write(addr, wdata, be);
+}
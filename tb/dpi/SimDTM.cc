@@ -1,5 +1,6 @@
 // See LICENSE.SiFive for license details.
 #include "msim_helper.h"
+#include "replay.h"
 
 #include <fesvr/dtm.h>
 #include <vpi_user.h>
@@ -9,6 +10,39 @@
 #include <vector>
 
 dtm_t* dtm;
+// there is no program to load (the memory has been preloaded), the debug
+// transport stays idle and no DTM is created
+bool dtm_disabled = false;
+
+// Pass the DTM outputs through the replay log (see replay.h). When replaying
+// the DTM does not run at all and the recorded outputs are driven instead.
+static int replay_tick
+(
+  unsigned char* debug_req_valid,
+  int*           debug_req_bits_addr,
+  int*           debug_req_bits_op,
+  int*           debug_req_bits_data,
+  unsigned char* debug_resp_ready,
+  int            ret
+)
+{
+  uint64_t req = replay->value(replay_t::DEBUG_REQ,
+                               (uint64_t) (*debug_req_valid & 0x1)              |
+                               (uint64_t) (*debug_resp_ready & 0x1)       << 1  |
+                               (uint64_t) (*debug_req_bits_op & 0x3)      << 2  |
+                               (uint64_t) (*debug_req_bits_addr & 0x7f)   << 4  |
+                               (uint64_t) (uint32_t) *debug_req_bits_data << 11);
+  *debug_req_valid     = req & 0x1;
+  *debug_resp_ready    = (req >> 1) & 0x1;
+  *debug_req_bits_op   = (req >> 2) & 0x3;
+  *debug_req_bits_addr = (req >> 4) & 0x7f;
+  *debug_req_bits_data = (req >> 11) & 0xffffffff;
+
+  ret = replay->value(replay_t::DEBUG_EXIT, ret);
+  if (replay->replaying() && (ret & 0x1))
+    replay->finish(ret >> 1);
+  return ret;
+}
 
 extern "C" int debug_tick
 (
@@ -24,6 +58,27 @@ extern "C" int debug_tick
 )
 {
 
+  if (replay && replay->replaying()) {
+    return replay_tick(debug_req_valid, debug_req_bits_addr, debug_req_bits_op,
+                       debug_req_bits_data, debug_resp_ready, 0);
+  }
+
+  int ret = 0;
+
+  if (dtm_disabled) {
+    *debug_req_valid     = 0;
+    *debug_resp_ready    = 1;
+    *debug_req_bits_addr = 0;
+    *debug_req_bits_op   = 0;
+    *debug_req_bits_data = 0;
+
+    if (replay) {
+      ret = replay_tick(debug_req_valid, debug_req_bits_addr, debug_req_bits_op,
+                        debug_req_bits_data, debug_resp_ready, ret);
+    }
+    return ret;
+  }
+
   if (!dtm) {
 
       std::vector<std::string> htif_args = sanitize_args();
@@ -56,5 +111,12 @@ extern "C" int debug_tick
   *debug_req_bits_op = dtm->req_bits().op;
   *debug_req_bits_data = dtm->req_bits().data;
 
-  return dtm->done() ? (dtm->exit_code() << 1 | 1) : 0;
+  ret = dtm->done() ? (dtm->exit_code() << 1 | 1) : 0;
+
+  if (replay) {
+    ret = replay_tick(debug_req_valid, debug_req_bits_addr, debug_req_bits_op,
+                       debug_req_bits_data, debug_resp_ready, ret);
+  }
+
+  return ret;
 }
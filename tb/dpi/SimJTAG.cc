@@ -2,8 +2,36 @@
 
 #include <cstdlib>
 #include "remote_bitbang.h"
+#include "replay.h"
 
 remote_bitbang_t* jtag;
+
+// Pass the pins driven by the remote bitbang client through the replay log
+// (see replay.h), no client is needed when replaying.
+static int replay_tick
+(
+ unsigned char * jtag_TCK,
+ unsigned char * jtag_TMS,
+ unsigned char * jtag_TDI,
+ unsigned char * jtag_TRSTn,
+ int ret
+)
+{
+  uint64_t pins = replay->value(replay_t::JTAG_PINS,
+                                (*jtag_TCK & 0x1)        |
+                                (*jtag_TMS & 0x1)   << 1 |
+                                (*jtag_TDI & 0x1)   << 2 |
+                                (*jtag_TRSTn & 0x1) << 3);
+  *jtag_TCK   = pins & 0x1;
+  *jtag_TMS   = (pins >> 1) & 0x1;
+  *jtag_TDI   = (pins >> 2) & 0x1;
+  *jtag_TRSTn = (pins >> 3) & 0x1;
+
+  ret = replay->value(replay_t::JTAG_EXIT, ret);
+  if (replay->replaying() && (ret & 0x1))
+    replay->finish(ret >> 1);
+  return ret;
+}
 extern "C" int jtag_tick
 (
  unsigned char * jtag_TCK,
@@ -13,6 +41,10 @@ extern "C" int jtag_tick
  unsigned char jtag_TDO
 )
 {
+  if (replay && replay->replaying()) {
+    return replay_tick(jtag_TCK, jtag_TMS, jtag_TDI, jtag_TRSTn, 0);
+  }
+
   if (!jtag) {
     // TODO: Pass in real port number
     jtag = new remote_bitbang_t(0);
@@ -20,6 +52,12 @@ extern "C" int jtag_tick
 
   jtag->tick(jtag_TCK, jtag_TMS, jtag_TDI, jtag_TRSTn, jtag_TDO);
 
-  return jtag->done() ? (jtag->exit_code() << 1 | 1) : 0;
+  int ret = jtag->done() ? (jtag->exit_code() << 1 | 1) : 0;
+
+  if (replay) {
+    ret = replay_tick(jtag_TCK, jtag_TMS, jtag_TDI, jtag_TRSTn, ret);
+  }
+
+  return ret;
 
 }
@@ -0,0 +1,122 @@
+// Description: File backed main memory for the simulation test-harness
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <cassert>
+#include <cstdio>
+
+#include "dram_image.h"
+
+dram_image_t::dram_image_t(const char* filename, bool shared) :
+  filename(filename ? filename : ""),
+  shared(shared),
+  mem(NULL),
+  size(0),
+  fd(-1)
+{
+}
+
+dram_image_t::~dram_image_t()
+{
+  if (mem) {
+    // make sure the final memory state hits the file
+    if (shared)
+      msync(mem, size, MS_SYNC);
+    munmap(mem, size);
+  }
+  if (fd != -1)
+    close(fd);
+}
+
+void dram_image_t::map(size_t size)
+{
+  // already mapped (e.g.: the memory model got re-initialized)
+  if (mem)
+    return;
+
+  this->size = size;
+
+  // reserve the whole address range with lazily allocated zero pages, the
+  // image gets mapped on top of it
+  mem = (uint8_t*) mmap(NULL, size, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (mem == MAP_FAILED) {
+    fprintf(stderr, "dram_image failed to reserve %zu bytes: %s (%d)\n",
+            size, strerror(errno), errno);
+    abort();
+  }
+
+  if (filename.empty())
+    return;
+
+  fd = open(filename.c_str(), shared ? O_RDWR | O_CREAT : O_RDONLY, 0644);
+  if (fd == -1) {
+    fprintf(stderr, "dram_image failed to open %s: %s (%d)\n",
+            filename.c_str(), strerror(errno), errno);
+    abort();
+  }
+
+  struct stat s;
+  if (fstat(fd, &s) < 0) {
+    fprintf(stderr, "dram_image failed to stat %s: %s (%d)\n",
+            filename.c_str(), strerror(errno), errno);
+    abort();
+  }
+
+  size_t len = s.st_size;
+  // a shared image covers the entire memory so that the complete final state
+  // can be inspected, the file is sparse where the core never wrote
+  if (shared && len < size) {
+    if (ftruncate(fd, size) < 0) {
+      fprintf(stderr, "dram_image failed to resize %s: %s (%d)\n",
+              filename.c_str(), strerror(errno), errno);
+      abort();
+    }
+    len = size;
+  }
+
+  if (len > size) {
+    fprintf(stderr, "dram_image: %s is larger than the memory (%zu bytes), "
+            "ignoring the remainder\n", filename.c_str(), size);
+    len = size;
+  }
+
+  if (len == 0)
+    return;
+
+  void* image = mmap(mem, len, PROT_READ | PROT_WRITE,
+                     (shared ? MAP_SHARED : MAP_PRIVATE) | MAP_FIXED, fd, 0);
+  if (image == MAP_FAILED) {
+    fprintf(stderr, "dram_image failed to map %s: %s (%d)\n",
+            filename.c_str(), strerror(errno), errno);
+    abort();
+  }
+}
+
+uint64_t dram_image_t::read(uint64_t addr)
+{
+  assert(addr + sizeof(uint64_t) <= size);
+  uint64_t rdata;
+  memcpy(&rdata, mem + addr, sizeof(uint64_t));
+  return rdata;
+}
+
+void dram_image_t::write(uint64_t addr, uint64_t wdata, uint8_t be)
+{
+  assert(addr + sizeof(uint64_t) <= size);
+  if (be == 0xff) {
+    memcpy(mem + addr, &wdata, sizeof(uint64_t));
+    return;
+  }
+
+  for (int i = 0; i < 8; i++) {
+    if (be & (1 << i))
+      mem[addr + i] = (wdata >> (i * 8)) & 0xff;
+  }
+}
@@ -0,0 +1,39 @@
+// Description: File backed main memory for the simulation test-harness
+
+#ifndef DRAM_IMAGE_H
+#define DRAM_IMAGE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+
+class dram_image_t
+{
+public:
+  // Back the memory with `filename` (may be NULL for zero-initialized
+  // memory). A shared image is mapped with MAP_SHARED so that every store
+  // of the simulated core ends up in the file (post-mortem inspection), a
+  // private image is copy-on-write and leaves the file untouched.
+  dram_image_t(const char* filename, bool shared);
+  ~dram_image_t();
+
+  // Map `size` bytes of memory. Called once the memory size is known (i.e.:
+  // from the elaborated SystemVerilog memory model).
+  void map(size_t size);
+
+  uint64_t read(uint64_t addr);
+  void write(uint64_t addr, uint64_t wdata, uint8_t be);
+
+  // Raw access to the backing store (e.g.: for preloading).
+  uint8_t* data() {return mem;}
+  size_t length() {return size;}
+
+ private:
+  std::string filename;
+  bool shared;
+  uint8_t* mem;
+  size_t size;
+  int fd;
+};
+
+#endif
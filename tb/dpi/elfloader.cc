@@ -14,28 +14,230 @@
 #include <stdio.h>
 #include <vector>
 #include <map>
+#include <thread>
+#include <algorithm>
 #include <iostream>
 
 #define SHT_PROGBITS 0x1
 #define SHT_GROUP 0x11
+#define SHT_NOBITS 0x8
+#define STT_SECTION 3
+#define STT_FILE 4
+
+// The laid out memory image of an ELF can be cached on disk, point
+// ARIANE_ELF_CACHE to a (shared) directory to enable it. The cache is keyed by
+// the hash of the ELF content, subsequent runs of the same binary only map
+// the cached image and skip parsing.
+#define ELF_CACHE_ENV "ARIANE_ELF_CACHE"
+#define ELF_CACHE_MAGIC 0x3268636163666c65ULL // "elfcach2", bump on format changes
+#define ELF_CACHE_ALIGN 4096
+#define ELF_HASH_CHUNK (4 << 20)
+
+// return values of read_section/read_section_chunk
+#define ELF_SECTION_OK 0
+#define ELF_SECTION_UNKNOWN 1
+#define ELF_SECTION_OUT_OF_BOUNDS 2
+
+struct elf_cache_header_t {
+    uint64_t magic;
+    uint64_t hash;
+    uint64_t entry;
+    uint64_t nr_sections;
+    uint64_t nr_symbols;
+    uint64_t symbols_offset;
+};
+
+struct elf_cache_section_t {
+    uint64_t address;
+    uint64_t memsz;
+    uint64_t filesz;
+    uint64_t offset;
+};
+
+struct elf_cache_symbol_t {
+    uint64_t address;
+    uint64_t name_offset; // relative to the end of the symbol table
+};
+
+// content of a section, everything past filesz (up to memsz) reads as zero
+struct mem_t {
+    const uint8_t* data;
+    reg_t filesz;
+    reg_t memsz;
+};
 
 // address and size
 std::vector<std::pair<reg_t, reg_t>> sections;
-std::map<std::string, uint64_t> symbols;
-// memory based address and content
-std::map<reg_t, std::vector<uint8_t>> mems;
+// name and address of every symbol, sorted by name. Local symbols of different
+// objects can share a name, lookups by name return the first definition.
+std::vector<std::pair<std::string, uint64_t>> symbols;
+// address and name, sorted by address (names point into symbols)
+std::vector<std::pair<uint64_t, const char*>> symbol_index;
+// memory based address and content (points into the mapped ELF or cached image)
+std::map<reg_t, mem_t> mems;
 reg_t entry;
 int section_index = 0;
 
-void write (uint64_t address, uint64_t len, uint8_t* buf) {
-    uint64_t datum;
-    std::vector<uint8_t> mem;
-    for (int i = 0; i < len; i++) {
-        mem.push_back(buf[i]);
-    }
+void write (uint64_t address, uint64_t len, uint64_t memsz, uint8_t* buf) {
+    mem_t mem = {buf, len, memsz};
     mems.insert(std::make_pair(address, mem));
 }
 
+// Sort the symbol table and build the address index. Lookups are binary
+// searches on flat vectors so they are cheap enough to be done every cycle.
+// Duplicate names are kept, dropping them would attribute the addresses of
+// the dropped definition to the symbol below it.
+static void index_symbols() {
+    std::stable_sort(symbols.begin(), symbols.end(),
+        [](const std::pair<std::string, uint64_t> &a, const std::pair<std::string, uint64_t> &b) { return a.first < b.first; });
+
+    symbol_index.clear();
+    for (auto &symbol : symbols)
+        symbol_index.push_back(std::make_pair(symbol.second, symbol.first.c_str()));
+    std::stable_sort(symbol_index.begin(), symbol_index.end(),
+        [](const std::pair<uint64_t, const char*> &a, const std::pair<uint64_t, const char*> &b) { return a.first < b.first; });
+}
+
+static uint64_t fnv1a(const uint8_t* buf, size_t len, uint64_t hash = 0xcbf29ce484222325ULL) {
+    for (size_t i = 0; i < len; i++) {
+        hash ^= buf[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+// Hash the file in fixed size chunks on all available cores, the result does
+// not depend on the number of threads.
+static uint64_t hash_elf(const uint8_t* buf, size_t size) {
+    size_t nr_chunks = (size + ELF_HASH_CHUNK - 1) / ELF_HASH_CHUNK;
+    std::vector<uint64_t> hashes(nr_chunks + 1);
+    size_t nr_threads = std::max(1u, std::thread::hardware_concurrency());
+    nr_threads = std::min(nr_threads, nr_chunks);
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < nr_threads; t++) {
+        threads.push_back(std::thread([=, &hashes]() {
+            for (size_t i = t; i < nr_chunks; i += nr_threads)
+                hashes[i] = fnv1a(buf + i * ELF_HASH_CHUNK, std::min((size_t) ELF_HASH_CHUNK, size - i * ELF_HASH_CHUNK));
+        }));
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    hashes[nr_chunks] = size;
+    return fnv1a((const uint8_t*) hashes.data(), hashes.size() * sizeof(uint64_t));
+}
+
+static std::string cache_path(uint64_t hash) {
+    char name[32];
+    snprintf(name, sizeof(name), "/%016llx.img", (unsigned long long) hash);
+    return std::string(getenv(ELF_CACHE_ENV)) + name;
+}
+
+// Map a cached image, returns false if there is no (valid) cache entry.
+static bool load_cache(uint64_t hash) {
+    std::string path = cache_path(hash);
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+        return false;
+
+    struct stat s;
+    if (fstat(fd, &s) < 0 || (size_t) s.st_size < sizeof(elf_cache_header_t)) {
+        close(fd);
+        return false;
+    }
+    size_t size = s.st_size;
+
+    // the mapping stays alive for the rest of the simulation
+    const uint8_t* buf = (const uint8_t*) mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (buf == MAP_FAILED)
+        return false;
+
+    const elf_cache_header_t* header = (const elf_cache_header_t*) buf;
+    const elf_cache_section_t* table = (const elf_cache_section_t*) (header + 1);
+
+    bool valid = header->magic == ELF_CACHE_MAGIC && header->hash == hash &&
+                 size >= sizeof(*header) + header->nr_sections * sizeof(*table);
+    for (uint64_t i = 0; valid && i < header->nr_sections; i++)
+        valid = table[i].filesz <= table[i].memsz && table[i].offset + table[i].filesz <= size;
+
+    const elf_cache_symbol_t* symtab = (const elf_cache_symbol_t*) (buf + header->symbols_offset);
+    const char* strtab = (const char*) (symtab + header->nr_symbols);
+    valid = valid && header->symbols_offset <= size &&
+            header->nr_symbols <= (size - header->symbols_offset) / sizeof(*symtab);
+    for (uint64_t i = 0; valid && i < header->nr_symbols; i++) {
+        size_t max_len = buf + size - (const uint8_t*) strtab;
+        valid = symtab[i].name_offset < max_len &&
+                strnlen(strtab + symtab[i].name_offset, max_len - symtab[i].name_offset) < max_len - symtab[i].name_offset;
+    }
+
+    if (!valid) {
+        std::cerr << "[ELF] Ignoring corrupted cache entry " << path << std::endl;
+        munmap((void*) buf, size);
+        return false;
+    }
+
+    entry = header->entry;
+    for (uint64_t i = 0; i < header->nr_sections; i++) {
+        sections.push_back(std::make_pair(table[i].address, table[i].memsz));
+        write(table[i].address, table[i].filesz, table[i].memsz, (uint8_t*) buf + table[i].offset);
+    }
+    for (uint64_t i = 0; i < header->nr_symbols; i++)
+        symbols.push_back(std::make_pair(std::string(strtab + symtab[i].name_offset), symtab[i].address));
+    index_symbols();
+    return true;
+}
+
+// Write the laid out image to the cache. The file is written under a temporary
+// name and atomically renamed, so concurrent runs never see a partial entry.
+static void store_cache(uint64_t hash) {
+    std::string path = cache_path(hash);
+    std::string tmp = path + "." + std::to_string(getpid());
+
+    FILE* fp = fopen(tmp.c_str(), "wb");
+    if (!fp) {
+        std::cerr << "[ELF] Could not create cache entry " << tmp << std::endl;
+        return;
+    }
+
+    elf_cache_header_t header = {ELF_CACHE_MAGIC, hash, entry, sections.size(), symbols.size(), 0};
+    std::vector<elf_cache_section_t> table;
+
+    uint64_t offset = sizeof(header) + sections.size() * sizeof(elf_cache_section_t);
+    for (auto &section : sections) {
+        auto &mem = mems.find(section.first)->second;
+        offset = (offset + ELF_CACHE_ALIGN - 1) & ~(uint64_t) (ELF_CACHE_ALIGN - 1);
+        table.push_back({section.first, section.second, mem.filesz, offset});
+        offset += mem.filesz;
+    }
+
+    // symbols and their names go after the last section
+    std::vector<elf_cache_symbol_t> symtab;
+    std::string strtab;
+    for (auto &symbol : symbols) {
+        symtab.push_back({symbol.second, strtab.size()});
+        strtab.append(symbol.first.c_str(), symbol.first.size() + 1);
+    }
+    header.symbols_offset = (offset + sizeof(uint64_t) - 1) & ~(uint64_t) (sizeof(uint64_t) - 1);
+
+    bool ok = fwrite(&header, sizeof(header), 1, fp) == 1 &&
+              fwrite(table.data(), sizeof(elf_cache_section_t), table.size(), fp) == table.size();
+    for (size_t i = 0; ok && i < table.size(); i++) {
+        auto &mem = mems.find(table[i].address)->second;
+        ok = fseek(fp, table[i].offset, SEEK_SET) == 0 &&
+             fwrite(mem.data, 1, mem.filesz, fp) == mem.filesz;
+    }
+    ok = ok && fseek(fp, header.symbols_offset, SEEK_SET) == 0 &&
+         fwrite(symtab.data(), sizeof(elf_cache_symbol_t), symtab.size(), fp) == symtab.size() &&
+         fwrite(strtab.data(), 1, strtab.size(), fp) == strtab.size();
+
+    if (fclose(fp) != 0 || !ok || rename(tmp.c_str(), path.c_str()) != 0) {
+        std::cerr << "[ELF] Could not write cache entry " << path << std::endl;
+        unlink(tmp.c_str());
+    }
+}
+
 // Communicate the section address and len
 // Returns:
 // 0 if there are no more sections
@@ -49,17 +251,68 @@ extern "C" char get_section (long long* address, long long* len) {
     } else return 0;
 }
 
-extern "C" char read_section (long long address, const svOpenArrayHandle buffer) {
-    // get actual poitner
-    void* buf = svGetArrayPtr(buffer);
+// Copy len bytes starting at offset of the section at address into buffer.
+// Sections can be streamed in chunks of bounded size this way.
+// Returns:
+// ELF_SECTION_OK if the chunk has been copied
+// ELF_SECTION_UNKNOWN if the address does not point to a section
+// ELF_SECTION_OUT_OF_BOUNDS if the chunk exceeds the section or the buffer
+extern "C" char read_section_chunk (long long address, long long offset, const svOpenArrayHandle buffer, long long len) {
     // check that the address points to a section
-    assert(mems.count(address) > 0);
-    // copy array
-    int i = 0;
-    for (auto &datum : mems.find(address)->second) {
-      *((char *) buf + i) = datum;
-      i++;
+    auto it = mems.find(address);
+    if (it == mems.end())
+      return ELF_SECTION_UNKNOWN;
+
+    const mem_t &mem = it->second;
+    if (offset < 0 || len < 0 || (reg_t) (offset + len) > mem.memsz || len > svSize(buffer, 1))
+      return ELF_SECTION_OUT_OF_BOUNDS;
+
+    // get actual pointer
+    uint8_t* buf = (uint8_t*) svGetArrayPtr(buffer);
+    // copy the initialized part and zero the rest
+    reg_t n = (reg_t) offset < mem.filesz ? std::min((reg_t) len, (reg_t) (mem.filesz - offset)) : 0;
+    memcpy(buf, mem.data + offset, n);
+    memset(buf + n, 0, len - n);
+    return ELF_SECTION_OK;
+}
+
+// Copy an entire section, the buffer needs to hold the whole section.
+extern "C" char read_section (long long address, const svOpenArrayHandle buffer) {
+    auto it = mems.find(address);
+    if (it == mems.end())
+      return ELF_SECTION_UNKNOWN;
+
+    return read_section_chunk(address, 0, buffer, it->second.memsz);
+}
+
+// Look up the address of a symbol, the first definition if the name is
+// defined more than once
+// Returns:
+// 0 if there is no such symbol
+// 1 if the symbol has been found
+extern "C" char get_symbol_address (const char* name, long long* address) {
+    auto it = std::lower_bound(symbols.begin(), symbols.end(), name,
+        [](const std::pair<std::string, uint64_t> &symbol, const char* name) { return strcmp(symbol.first.c_str(), name) < 0; });
+    if (it == symbols.end() || it->first != name)
+      return 0;
+
+    *address = it->second;
+    return 1;
+}
+
+// Symbolize an address: returns the name of the closest symbol at or below
+// address (an empty string if there is none) and the offset into it.
+extern "C" const char* get_symbol_name (long long address, long long* offset) {
+    auto it = std::upper_bound(symbol_index.begin(), symbol_index.end(), (uint64_t) address,
+        [](uint64_t address, const std::pair<uint64_t, const char*> &symbol) { return address < symbol.first; });
+    if (it == symbol_index.begin()) {
+      *offset = address;
+      return "";
     }
+
+    --it;
+    *offset = address - it->first;
+    return it->second;
 }
 
 extern "C" void read_elf(const char* filename) {
@@ -70,6 +323,7 @@ extern "C" void read_elf(const char* filename) {
     abort();
     size_t size = s.st_size;
 
+    // the mapping stays alive as the sections point into it
     char* buf = (char*)mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
     assert(buf != MAP_FAILED);
     close(fd);
@@ -78,10 +332,18 @@ extern "C" void read_elf(const char* filename) {
     const Elf64_Ehdr* eh64 = (const Elf64_Ehdr*)buf;
     assert(IS_ELF32(*eh64) || IS_ELF64(*eh64));
 
+    bool use_cache = getenv(ELF_CACHE_ENV) != NULL;
+    uint64_t hash = 0;
 
+    if (use_cache) {
+      hash = hash_elf((const uint8_t*) buf, size);
+      if (load_cache(hash)) {
+        munmap(buf, size);
+        return;
+      }
+    }
 
     std::vector<uint8_t> zeros;
-    std::map<std::string, uint64_t> symbols;
 
     #define LOAD_ELF(ehdr_t, phdr_t, shdr_t, sym_t) do { \
     ehdr_t* eh = (ehdr_t*)buf; \
@@ -93,7 +355,7 @@ extern "C" void read_elf(const char* filename) {
         if (ph[i].p_filesz) { \
           assert(size >= ph[i].p_offset + ph[i].p_filesz); \
           sections.push_back(std::make_pair(ph[i].p_paddr, ph[i].p_memsz)); \
-          write(ph[i].p_paddr, ph[i].p_filesz, (uint8_t*)buf + ph[i].p_offset); \
+          write(ph[i].p_paddr, ph[i].p_filesz, ph[i].p_memsz, (uint8_t*)buf + ph[i].p_offset); \
         } \
         zeros.resize(ph[i].p_memsz - ph[i].p_filesz); \
       } \
@@ -108,7 +370,7 @@ extern "C" void read_elf(const char* filename) {
       unsigned max_len = sh[eh->e_shstrndx].sh_size - sh[i].sh_name; \
       if ((sh[i].sh_type & SHT_GROUP) && strcmp(shstrtab + sh[i].sh_name, ".strtab") != 0 && strcmp(shstrtab + sh[i].sh_name, ".shstrtab") != 0) \
       assert(strnlen(shstrtab + sh[i].sh_name, max_len) < max_len); \
-      if (sh[i].sh_type & SHT_PROGBITS) continue; \
+      if (sh[i].sh_type & SHT_NOBITS) continue; \
       if (strcmp(shstrtab + sh[i].sh_name, ".strtab") == 0) \
         strtabidx = i; \
       if (strcmp(shstrtab + sh[i].sh_name, ".symtab") == 0) \
@@ -121,7 +383,10 @@ extern "C" void read_elf(const char* filename) {
         unsigned max_len = sh[strtabidx].sh_size - sym[i].st_name; \
         assert(sym[i].st_name < sh[strtabidx].  sh_size); \
         assert(strnlen(strtab + sym[i].st_name, max_len) < max_len); \
-        symbols[strtab + sym[i].st_name] = sym[i].st_value; \
+        if (strtab[sym[i].st_name] == '\0' || sym[i].st_shndx == 0 || \
+            (sym[i].st_info & 0xf) == STT_SECTION || (sym[i].st_info & 0xf) == STT_FILE) \
+          continue; \
+        symbols.push_back(std::make_pair(std::string(strtab + sym[i].st_name), (uint64_t) sym[i].st_value)); \
       } \
     } \
     } while(0)
@@ -131,5 +396,8 @@ extern "C" void read_elf(const char* filename) {
   else
     LOAD_ELF(Elf64_Ehdr, Elf64_Phdr, Elf64_Shdr, Elf64_Sym);
 
-  munmap(buf, size);
+  index_symbols();
+
+  if (use_cache)
+    store_cache(hash);
 }
@@ -0,0 +1,111 @@
+// Description: Record and replay of the nondeterministic simulation inputs
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "replay.h"
+
+#define REPLAY_MAGIC "ARIANERR"
+#define REPLAY_MAGIC_LEN 8
+
+replay_t* replay;
+
+replay_t::replay_t(const char* filename, bool record) :
+  record(record),
+  quit(0),
+  err(0)
+{
+  for (int i = 0; i < NR_STREAMS; i++) {
+    calls[i] = 0;
+    last_call[i] = 0;
+    last_value[i] = 0;
+    next[i] = 0;
+  }
+
+  fp = fopen(filename, record ? "wb" : "rb");
+  if (!fp) {
+    fprintf(stderr, "replay failed to open %s: %s (%d)\n",
+            filename, strerror(errno), errno);
+    abort();
+  }
+
+  if (record) {
+    fwrite(REPLAY_MAGIC, 1, REPLAY_MAGIC_LEN, fp);
+    return;
+  }
+
+  char magic[REPLAY_MAGIC_LEN];
+  if (fread(magic, 1, REPLAY_MAGIC_LEN, fp) != REPLAY_MAGIC_LEN ||
+      memcmp(magic, REPLAY_MAGIC, REPLAY_MAGIC_LEN) != 0) {
+    fprintf(stderr, "replay: %s is not a replay log\n", filename);
+    abort();
+  }
+
+  // the log is compact, read all of it upfront
+  uint64_t stream, delta, value;
+  while (get(&stream)) {
+    if (stream >= NR_STREAMS || !get(&delta) || !get(&value)) {
+      fprintf(stderr, "replay: %s is corrupted\n", filename);
+      abort();
+    }
+    last_call[stream] += delta;
+    changes[stream].push_back({last_call[stream], value});
+  }
+  fclose(fp);
+  fp = NULL;
+}
+
+replay_t::~replay_t()
+{
+  if (fp)
+    fclose(fp);
+}
+
+uint64_t replay_t::value(stream_t stream, uint64_t value)
+{
+  uint64_t call = calls[stream]++;
+
+  if (record) {
+    if (call == 0 || value != last_value[stream]) {
+      put(stream);
+      put(call - last_call[stream]);
+      put(value);
+      last_call[stream] = call;
+      last_value[stream] = value;
+      // keep the log usable if the simulation crashes later on
+      if (stream == SEED || stream == DEBUG_EXIT || stream == JTAG_EXIT)
+        fflush(fp);
+    }
+    return value;
+  }
+
+  // the value holds until the next recorded change
+  std::vector<change_t> &c = changes[stream];
+  while (next[stream] < c.size() && c[next[stream]].call <= call)
+    last_value[stream] = c[next[stream]++].value;
+  return last_value[stream];
+}
+
+void replay_t::put(uint64_t value)
+{
+  do {
+    uint8_t byte = value & 0x7f;
+    value >>= 7;
+    fputc(value ? byte | 0x80 : byte, fp);
+  } while (value);
+}
+
+bool replay_t::get(uint64_t* value)
+{
+  *value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    int byte = fgetc(fp);
+    if (byte == EOF)
+      return false;
+    *value |= (uint64_t) (byte & 0x7f) << shift;
+    if (!(byte & 0x80))
+      return true;
+  }
+  return false;
+}
@@ -0,0 +1,67 @@
+// Description: Record and replay of the nondeterministic simulation inputs
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+
+class replay_t
+{
+public:
+  // Every source of nondeterminism gets its own stream of values.
+  enum stream_t {
+    SEED,        // random seed of the emulator
+    DEBUG_REQ,   // outputs of debug_tick (fesvr DTM)
+    DEBUG_EXIT,  // return value of debug_tick
+    JTAG_PINS,   // outputs of jtag_tick (remote bitbang socket)
+    JTAG_EXIT,   // return value of jtag_tick
+    NR_STREAMS
+  };
+
+  // Record to or replay from `filename`.
+  replay_t(const char* filename, bool record);
+  ~replay_t();
+
+  bool replaying() {return !record;}
+
+  // Pass the value a stream produced this call through the log: when
+  // recording `value` is logged and returned, when replaying the value
+  // recorded for this call is returned instead.
+  uint64_t value(stream_t stream, uint64_t value);
+
+  // End of a replayed run, signalled by a replayed exit value
+  void finish(int code) {quit = 1; err = code;}
+  unsigned char done() {return quit;}
+  int exit_code() {return err;}
+
+ private:
+  // Only changes are logged: a record consists of the stream, the number of
+  // calls since the last change of that stream and the new value, all
+  // LEB128 encoded.
+  struct change_t {
+    uint64_t call;
+    uint64_t value;
+  };
+
+  bool record;
+  FILE* fp;
+
+  unsigned char quit;
+  int err;
+
+  uint64_t calls[NR_STREAMS];
+  uint64_t last_call[NR_STREAMS];
+  uint64_t last_value[NR_STREAMS];
+  // replay only: all changes per stream and the next one to apply
+  std::vector<change_t> changes[NR_STREAMS];
+  size_t next[NR_STREAMS];
+
+  void put(uint64_t value);
+  bool get(uint64_t* value);
+};
+
+extern replay_t* replay;
+
+#endif
@@ -0,0 +1,6 @@
+// Description: First half of the ELF used by elfloader_test, both halves
+//              define a local function called helper
+
+__attribute__((noinline, used)) static int helper(int x) { return x + 1; }
+
+int call_a(int x) { return helper(x); }
@@ -0,0 +1,9 @@
+// Description: Second half of the ELF used by elfloader_test
+
+__attribute__((noinline, used)) static int helper(int x) { return x * 3 + 2; }
+
+int call_b(int x) { return helper(x); }
+
+int call_a(int x);
+
+int main(int argc, char** argv) { return call_a(argc) + call_b(argc); }
@@ -0,0 +1,60 @@
+// Description: Checks the symbol lookups of elfloader.cc on an ELF which
+//              defines the same local symbol in two objects
+//
+// Usage: elfloader_test <elf> <address of the first helper> <address of the second helper>
+
+#include <svdpi.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern "C" void read_elf(const char* filename);
+extern "C" char get_symbol_address(const char* name, long long* address);
+extern "C" const char* get_symbol_name(long long address, long long* offset);
+
+// the section readers are not exercised, they only need to link
+extern "C" int svSize(const svOpenArrayHandle h, int d) { return 0; }
+extern "C" void* svGetArrayPtr(const svOpenArrayHandle h) { return NULL; }
+
+static int errors = 0;
+
+static void check_name(long long address, const char* name, long long offset) {
+    long long actual_offset;
+    const char* actual = get_symbol_name(address, &actual_offset);
+    if (strcmp(actual, name) != 0 || actual_offset != offset) {
+        fprintf(stderr, "[elfloader_test] 0x%llx: expected %s+%lld, got %s+%lld\n",
+                address, name, offset, actual, actual_offset);
+        errors++;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc != 4) {
+        fprintf(stderr, "usage: %s <elf> <helper address> <helper address>\n", argv[0]);
+        return 2;
+    }
+
+    long long helper[2] = {strtoll(argv[2], NULL, 0), strtoll(argv[3], NULL, 0)};
+    read_elf(argv[1]);
+
+    // both definitions symbolize, at their start and inside of them
+    for (int i = 0; i < 2; i++) {
+        check_name(helper[i], "helper", 0);
+        check_name(helper[i] + 1, "helper", 1);
+    }
+
+    // a lookup by name returns one of the definitions
+    long long address;
+    if (!get_symbol_address("helper", &address) || (address != helper[0] && address != helper[1])) {
+        fprintf(stderr, "[elfloader_test] helper does not resolve to one of its definitions\n");
+        errors++;
+    }
+    if (get_symbol_address("no_such_symbol", &address)) {
+        fprintf(stderr, "[elfloader_test] no_such_symbol resolved to 0x%llx\n", address);
+        errors++;
+    }
+
+    printf("[elfloader_test] %s\n", errors ? "FAILED" : "PASSED");
+    return errors ? 1 : 0;
+}
@@ -51,6 +51,10 @@ module tb;
 
   parameter Verbose           = 0;
 
+  // the write buffer sits on the last port, all others are read ports
+  localparam NumRdPorts       = NR_DCACHE_PORTS-1;
+  localparam WrPort           = NR_DCACHE_PORTS-1;
+
 ///////////////////////////////////////////////////////////////////////////////
 // MUT signal declarations
 ///////////////////////////////////////////////////////////////////////////////
@@ -62,8 +66,8 @@ module tb;
   logic                           wbuffer_empty_o;
   amo_req_t                       amo_req_i;
   amo_resp_t                      amo_resp_o;
-  dcache_req_i_t [2:0]            req_ports_i;
-  dcache_req_o_t [2:0]            req_ports_o;
+  dcache_req_i_t [NR_DCACHE_PORTS-1:0] req_ports_i;
+  dcache_req_o_t [NR_DCACHE_PORTS-1:0] req_ports_o;
   logic                           mem_rtrn_vld_i;
   dcache_rtrn_t                   mem_rtrn_i;
   logic                           mem_data_req_o;
@@ -79,9 +83,9 @@ module tb;
   string test_name;
   logic clk_i, rst_ni;
   logic [31:0] seq_num_resp, seq_num_write;
-  seq_t [2:0] seq_type;
-  logic [2:0] seq_done;
-  logic [6:0] req_rate[2:0];
+  seq_t [NR_DCACHE_PORTS-1:0] seq_type;
+  logic [NR_DCACHE_PORTS-1:0] seq_done;
+  logic [6:0] req_rate[NR_DCACHE_PORTS-1:0];
   logic seq_run, seq_last;
   logic end_of_sim;
 
@@ -104,15 +108,19 @@ module tb;
     logic [63:0] paddr;
   } resp_fifo_t;
 
-  logic [63:0] act_paddr[1:0];
-  logic [63:0] exp_rdata[1:0];
-  logic [63:0] exp_paddr[1:0];
-  resp_fifo_t  fifo_data_in[1:0];
-  resp_fifo_t  fifo_data[1:0];
-  logic [1:0]  fifo_push, fifo_pop, fifo_flush;
-  logic [2:0]  flush;
+  logic [63:0] act_paddr[NumRdPorts-1:0];
+  logic [63:0] exp_rdata[NumRdPorts-1:0];
+  logic [63:0] exp_paddr[NumRdPorts-1:0];
+  resp_fifo_t  fifo_data_in[NumRdPorts-1:0];
+  resp_fifo_t  fifo_data[NumRdPorts-1:0];
+  logic [NumRdPorts-1:0] fifo_push, fifo_pop, fifo_flush;
+  logic [NR_DCACHE_PORTS-1:0] flush;
   logic flush_rand_en;
 
+  // hit under miss: a read port gets a hit while another one waits for a refill
+  logic [NumRdPorts-1:0] miss_pending, hit_rvalid;
+  int unsigned           hit_under_miss_cnt, hit_under_miss_start;
+
 ///////////////////////////////////////////////////////////////////////////////
 // helper tasks
 ///////////////////////////////////////////////////////////////////////////////
@@ -129,9 +137,9 @@ module tb;
   endtask : runSeq
 
   task automatic flushCache();
-    flush[2]      = 1'b1;
+    flush[WrPort] = 1'b1;
     `APPL_WAIT_SIG(clk_i, flush_ack_o);
-    flush[2]      = 0'b0;
+    flush[WrPort] = 0'b0;
     `APPL_WAIT_CYC(clk_i,1)
   endtask : flushCache
 
@@ -225,17 +233,14 @@ module tb;
 // port emulation programs
 ///////////////////////////////////////////////////////////////////////////////
 
-  // get actual paddr from read controllers
-  assign act_paddr[0] = {i_dut.genblk1[0].i_serpent_dcache_ctrl.address_tag_d,
-                         i_dut.genblk1[0].i_serpent_dcache_ctrl.address_idx_q,
-                         i_dut.genblk1[0].i_serpent_dcache_ctrl.address_off_q};
-  assign act_paddr[1] = {i_dut.genblk1[1].i_serpent_dcache_ctrl.address_tag_d,
-                         i_dut.genblk1[1].i_serpent_dcache_ctrl.address_idx_q,
-                         i_dut.genblk1[1].i_serpent_dcache_ctrl.address_off_q};
-
-  // generate fifo queues for expected responses
   generate
-    for(genvar k=0; k<2;k++) begin
+    for(genvar k=0; k<NumRdPorts;k++) begin : g_rdport
+      // get actual paddr from read controllers
+      assign act_paddr[k] = {i_dut.genblk1[k].i_serpent_dcache_ctrl.address_tag_d,
+                             i_dut.genblk1[k].i_serpent_dcache_ctrl.address_idx_q,
+                             i_dut.genblk1[k].i_serpent_dcache_ctrl.address_off_q};
+
+      // generate fifo queues for expected responses
       assign fifo_data_in[k] =  {req_ports_i[k].data_size,
                                  exp_paddr[k]};
 
@@ -260,74 +265,59 @@ module tb;
         .data_o      ( fifo_data[k]     ),
         .pop_i       ( fifo_pop[k]      )
       );
+
+      assign miss_pending[k] = i_dut.genblk1[k].i_serpent_dcache_ctrl.state_q inside {i_dut.genblk1[k].i_serpent_dcache_ctrl.MISS_REQ,
+                                                                                      i_dut.genblk1[k].i_serpent_dcache_ctrl.MISS_WAIT};
+      assign hit_rvalid[k]   = req_ports_o[k].data_rvalid & ~req_ports_i[k].kill_req &
+                               (i_dut.genblk1[k].i_serpent_dcache_ctrl.state_q inside {i_dut.genblk1[k].i_serpent_dcache_ctrl.READ,
+                                                                                       i_dut.genblk1[k].i_serpent_dcache_ctrl.REPLAY_READ});
+
+      tb_readport #(
+        .PortName      ( {"RD", byte'("0" + k)} ),
+        .FlushRate     ( FlushRate              ),
+        .KillRate      ( KillRate               ),
+        .TlbHitRate    ( TlbHitRate             ),
+        .MemWords      ( MemWords               ),
+        .CachedAddrBeg ( CachedAddrBeg          ),
+        .CachedAddrEnd ( CachedAddrEnd          ),
+        .RndSeed       ( 5555555 - k*2222222    ),
+        .Verbose       ( Verbose                )
+      ) i_tb_readport (
+        .clk_i           ( clk_i               ),
+        .rst_ni          ( rst_ni              ),
+        .test_name_i     ( test_name           ),
+        .req_rate_i      ( req_rate[k]         ),
+        .seq_type_i      ( seq_type[k]         ),
+        .tlb_rand_en_i   ( tlb_rand_en         ),
+        .flush_rand_en_i ( flush_rand_en       ),
+        .seq_run_i       ( seq_run             ),
+        .seq_num_resp_i  ( seq_num_resp        ),
+        .seq_last_i      ( seq_last            ),
+        .seq_done_o      ( seq_done[k]         ),
+        .exp_paddr_o     ( exp_paddr[k]        ),
+        .exp_size_i      ( fifo_data[k].size   ),
+        .exp_paddr_i     ( fifo_data[k].paddr  ),
+        .exp_rdata_i     ( exp_rdata[k]        ),
+        .act_paddr_i     ( act_paddr[k]        ),
+        .flush_o         ( flush[k]            ),
+        .flush_ack_i     ( flush_ack_o         ),
+        .dut_req_port_o  ( req_ports_i[k]      ),
+        .dut_req_port_i  ( req_ports_o[k]      )
+      );
     end
   endgenerate
 
-  tb_readport #(
-    .PortName      ( "RD0"         ),
-    .FlushRate     ( FlushRate     ),
-    .KillRate      ( KillRate      ),
-    .TlbHitRate    ( TlbHitRate    ),
-    .MemWords      ( MemWords      ),
-    .CachedAddrBeg ( CachedAddrBeg ),
-    .CachedAddrEnd ( CachedAddrEnd ),
-    .RndSeed       ( 5555555       ),
-    .Verbose       ( Verbose       )
-  ) i_tb_readport0 (
-    .clk_i           ( clk_i               ),
-    .rst_ni          ( rst_ni              ),
-    .test_name_i     ( test_name           ),
-    .req_rate_i      ( req_rate[0]         ),
-    .seq_type_i      ( seq_type[0]         ),
-    .tlb_rand_en_i   ( tlb_rand_en         ),
-    .flush_rand_en_i ( flush_rand_en       ),
-    .seq_run_i       ( seq_run             ),
-    .seq_num_resp_i  ( seq_num_resp        ),
-    .seq_last_i      ( seq_last            ),
-    .seq_done_o      ( seq_done[0]         ),
-    .exp_paddr_o     ( exp_paddr[0]        ),
-    .exp_size_i      ( fifo_data[0].size   ),
-    .exp_paddr_i     ( fifo_data[0].paddr  ),
-    .exp_rdata_i     ( exp_rdata[0]        ),
-    .act_paddr_i     ( act_paddr[0]        ),
-    .flush_o         ( flush[0]            ),
-    .flush_ack_i     ( flush_ack_o         ),
-    .dut_req_port_o  ( req_ports_i[0]      ),
-    .dut_req_port_i  ( req_ports_o[0]      )
-    );
-
-  tb_readport #(
-    .PortName      ( "RD1"         ),
-    .FlushRate     ( FlushRate     ),
-    .KillRate      ( KillRate      ),
-    .TlbHitRate    ( TlbHitRate    ),
-    .MemWords      ( MemWords      ),
-    .CachedAddrBeg ( CachedAddrBeg ),
-    .CachedAddrEnd ( CachedAddrEnd ),
-    .RndSeed       ( 3333333       ),
-    .Verbose       ( Verbose       )
-  ) i_tb_readport1 (
-    .clk_i           ( clk_i               ),
-    .rst_ni          ( rst_ni              ),
-    .test_name_i     ( test_name           ),
-    .req_rate_i      ( req_rate[1]         ),
-    .seq_type_i      ( seq_type[1]         ),
-    .tlb_rand_en_i   ( tlb_rand_en         ),
-    .flush_rand_en_i ( flush_rand_en       ),
-    .seq_run_i       ( seq_run             ),
-    .seq_num_resp_i  ( seq_num_resp        ),
-    .seq_last_i      ( seq_last            ),
-    .exp_paddr_o     ( exp_paddr[1]        ),
-    .exp_size_i      ( fifo_data[1].size   ),
-    .exp_paddr_i     ( fifo_data[1].paddr  ),
-    .exp_rdata_i     ( exp_rdata[1]        ),
-    .act_paddr_i     ( act_paddr[1]        ),
-    .seq_done_o      ( seq_done[1]         ),
-    .flush_o         ( flush[1]            ),
-    .flush_ack_i     ( flush_ack_o         ),
-    .dut_req_port_o  ( req_ports_i[1]      ),
-    .dut_req_port_i  ( req_ports_o[1]      )
-  );
+  // count hits on one read port while another one has a miss outstanding
+  always_ff @(posedge clk_i or negedge rst_ni) begin : p_hit_under_miss
+    if (~rst_ni) begin
+      hit_under_miss_cnt <= 0;
+    end else begin
+      for (int k=0; k<NumRdPorts; k++) begin
+        if (hit_rvalid[k] && |(miss_pending & ~(NumRdPorts'(1) << k)))
+          hit_under_miss_cnt <= hit_under_miss_cnt + 1;
+      end
+    end
+  end
 
   tb_writeport #(
     .PortName      ( "WR0"         ),
@@ -340,20 +330,20 @@ module tb;
     .clk_i          ( clk_i               ),
     .rst_ni         ( rst_ni              ),
     .test_name_i    ( test_name           ),
-    .req_rate_i     ( req_rate[2]         ),
-    .seq_type_i     ( seq_type[2]         ),
+    .req_rate_i     ( req_rate[WrPort]    ),
+    .seq_type_i     ( seq_type[WrPort]    ),
     .seq_run_i      ( seq_run             ),
     .seq_num_vect_i ( seq_num_write       ),
     .seq_last_i     ( seq_last            ),
-    .seq_done_o     ( seq_done[2]         ),
-    .dut_req_port_o ( req_ports_i[2]      ),
-    .dut_req_port_i ( req_ports_o[2]      )
+    .seq_done_o     ( seq_done[WrPort]    ),
+    .dut_req_port_o ( req_ports_i[WrPort] ),
+    .dut_req_port_i ( req_ports_o[WrPort] )
   );
 
-  assign write_en    = req_ports_i[2].data_req & req_ports_o[2].data_gnt & req_ports_i[2].data_we;
-  assign write_paddr = {req_ports_i[2].address_tag,  req_ports_i[2].address_index};
-  assign write_data  = req_ports_i[2].data_wdata;
-  assign write_be    = req_ports_i[2].data_be;
+  assign write_en    = req_ports_i[WrPort].data_req & req_ports_o[WrPort].data_gnt & req_ports_i[WrPort].data_we;
+  assign write_paddr = {req_ports_i[WrPort].address_tag,  req_ports_i[WrPort].address_index};
+  assign write_data  = req_ports_i[WrPort].data_wdata;
+  assign write_be    = req_ports_i[WrPort].data_be;
 
   // generate write buffer commit signals based on internal eviction status
   assign commit_be    = i_dut.i_serpent_dcache_wbuffer.wr_data_be_o;
@@ -397,7 +387,7 @@ module tb;
     amo_rand_en      = 0;
     flush_rand_en    = 0;
     // cache ctrl
-    flush[2]         = 0;
+    flush[WrPort]    = 0;
     // flush_ack_o
     // wbuffer_empty_o
     enable_i         = 0;
@@ -532,8 +522,10 @@ module tb;
     tlb_rand_en  = 0;
     mem_rand_en  = 0;
     inv_rand_en  = 0;
-    seq_type     = '{LINEAR_SEQ, IDLE_SEQ, IDLE_SEQ};
-    req_rate     = '{100, 0, 0};
+    seq_type         = '{default: IDLE_SEQ};
+    seq_type[WrPort] = LINEAR_SEQ;
+    req_rate         = '{default: 0};
+    req_rate[WrPort] = 100;
     runSeq(0,5000);
     flushCache();
     memCheck();
@@ -544,10 +536,12 @@ module tb;
     tlb_rand_en  = 0;
     mem_rand_en  = 0;
     inv_rand_en  = 0;
-    seq_type     = '{IDLE_SEQ, IDLE_SEQ, LINEAR_SEQ};
+    seq_type     = '{default: IDLE_SEQ};
+    seq_type[0]  = LINEAR_SEQ;
     req_rate     = '{default:100};
     runSeq((CachedAddrBeg>>3)+(2**(DCACHE_INDEX_WIDTH-3))*DCACHE_SET_ASSOC,0);
-    seq_type     = '{LINEAR_SEQ, IDLE_SEQ, IDLE_SEQ};
+    seq_type         = '{default: IDLE_SEQ};
+    seq_type[WrPort] = LINEAR_SEQ;
     runSeq(0,(CachedAddrBeg>>3)+(2**(DCACHE_INDEX_WIDTH-3))*DCACHE_SET_ASSOC,1);
     flushCache();
     memCheck();
@@ -558,8 +552,10 @@ module tb;
     tlb_rand_en  = 0;
     mem_rand_en  = 0;
     inv_rand_en  = 0;
-    seq_type     = '{BURST_SEQ, RANDOM_SEQ, RANDOM_SEQ};
-    req_rate     = '{75, 0, 0};
+    seq_type         = '{default: RANDOM_SEQ};
+    seq_type[WrPort] = BURST_SEQ;
+    req_rate         = '{default: 0};
+    req_rate[WrPort] = 75;
     runSeq(0,5000,0);
     flushCache();
     memCheck();
@@ -570,8 +566,10 @@ module tb;
     tlb_rand_en  = 1;
     mem_rand_en  = 1;
     inv_rand_en  = 1;
-    seq_type     = '{BURST_SEQ, IDLE_SEQ, IDLE_SEQ};
-    req_rate     = '{75, 0, 0};
+    seq_type         = '{default: IDLE_SEQ};
+    seq_type[WrPort] = BURST_SEQ;
+    req_rate         = '{default: 0};
+    req_rate[WrPort] = 75;
     runSeq(0,5000);
     flushCache();
     memCheck();
@@ -582,7 +580,7 @@ module tb;
     tlb_rand_en  = 1;
     mem_rand_en  = 1;
     inv_rand_en  = 1;
-    seq_type     = '{RANDOM_SEQ, RANDOM_SEQ, RANDOM_SEQ};
+    seq_type     = '{default: RANDOM_SEQ};
     req_rate     = '{default:25};
     runSeq(5000,5000);
     flushCache();
@@ -594,20 +592,46 @@ module tb;
     tlb_rand_en  = 0;
     mem_rand_en  = 0;
     inv_rand_en  = 0;
-    seq_type     = '{WRAP_SEQ, IDLE_SEQ, WRAP_SEQ};
-    req_rate     = '{100,0,20};
+    seq_type         = '{default: IDLE_SEQ};
+    seq_type[0]      = WRAP_SEQ;
+    seq_type[WrPort] = WRAP_SEQ;
+    req_rate         = '{default: 0};
+    req_rate[0]      = 20;
+    req_rate[WrPort] = 100;
     runSeq(5000,5000);
     flushCache();
     memCheck();
     ///////////////////////////////////////////////
-    test_name    = "TEST 16 -- random write/read-- enabled cache + tlb, mem contentions + invalidations + random flushes";
+    test_name    = "TEST 16 -- hits on one read port while another one misses -- enabled cache + mem contentions";
+    // config
+    enable_i     = 1;
+    tlb_rand_en  = 0;
+    mem_rand_en  = 1;
+    inv_rand_en  = 0;
+    // port 0 mostly misses, port 1 keeps reading the same line
+    seq_type     = '{default: IDLE_SEQ};
+    seq_type[0]  = RANDOM_SEQ;
+    seq_type[1]  = WRAP_SEQ;
+    req_rate     = '{default: 0};
+    req_rate[0]  = 50;
+    req_rate[1]  = 100;
+    hit_under_miss_start = hit_under_miss_cnt;
+    runSeq(5000);
+    if (hit_under_miss_cnt == hit_under_miss_start)
+      $error("TB> no read port got a hit while another one had a miss outstanding");
+    else
+      $display("TB> %0d hits under miss", hit_under_miss_cnt - hit_under_miss_start);
+    flushCache();
+    memCheck();
+    ///////////////////////////////////////////////
+    test_name    = "TEST 17 -- random write/read-- enabled cache + tlb, mem contentions + invalidations + random flushes";
     // config
     enable_i      = 1;
     tlb_rand_en   = 1;
     mem_rand_en   = 1;
     inv_rand_en   = 1;
     flush_rand_en = 1;
-    seq_type      = '{RANDOM_SEQ, RANDOM_SEQ, RANDOM_SEQ};
+    seq_type      = '{default: RANDOM_SEQ};
     req_rate      = '{default:25};
     runSeq(5000,5000,1);// last sequence flag, terminates agents
     flushCache();